@@ -113,6 +113,9 @@ struct borg_read_message {
     char *message_p1;
     char *message_p2;
     char *message_p3;
+    int   id_p1; /* matcher pattern ids, -1 for a missing part */
+    int   id_p2;
+    int   id_p3;
 };
 
 struct borg_read_messages {
@@ -129,15 +132,314 @@ static struct borg_read_messages suffix_hit_by;
 static struct borg_read_messages spell_msgs;
 static struct borg_read_messages spell_invis_msgs;
 
-/* check a message for a string */
-static bool borg_message_contains(
-    const char *value, struct borg_read_message *message)
+/*
+ * Multi-pattern message matcher
+ *
+ * Every piece of text from the monster-derived tables above (and the pain
+ * suffixes) is compiled at init time into one Aho-Corasick automaton.  One
+ * pass over a message then finds every piece present, where it first starts
+ * and whether it ends the message.  Each piece knows which table entries
+ * ("rules") it starts, so finding the first matching entry of a table only
+ * looks at entries whose first piece is actually in the message, rather
+ * than running strstr() over every entry.
+ */
+enum {
+    BORG_MATCH_PAIN,
+    BORG_MATCH_HIT_BY,
+    BORG_MATCH_SPELL_INVIS,
+    BORG_MATCH_SPELL,
+    BORG_MATCH_TABLES
+};
+
+struct borg_match_state {
+    int           child;   /* first child state, 0 for none */
+    int           sibling; /* next state with the same parent, 0 for none */
+    int           fail;    /* longest proper suffix that is also a state */
+    int           dict;    /* nearest state along fail links ending a piece */
+    int           pattern; /* piece ending exactly here, or -1 */
+    unsigned char c;
+};
+
+struct borg_match_rule {
+    int table;
+    int entry;
+    int next;
+};
+
+static struct {
+    struct borg_match_state *states;
+    int                      num_states;
+    int                      alloc_states;
+    int                      root[256];
+
+    int      num_patterns;
+    int      alloc_patterns;
+    int     *len;       /* length of each piece */
+    int     *rules;     /* first rule started by each piece, -1 for none */
+    uint32_t *seen;     /* stamp of the last message containing the piece */
+    uint32_t *at_end;   /* stamp of the last message ending with it */
+    int     *start;     /* first start in that message */
+    int      empty;     /* id of the empty piece, -1 if none */
+
+    struct borg_match_rule *rule_list;
+    int                     num_rules;
+    int                     alloc_rules;
+
+    int     *hits;      /* pieces found in the current message */
+    int      num_hits;
+    uint32_t stamp;
+} borg_matcher;
+
+/* Add a state as a child of the given state */
+static int borg_match_new_state(int parent, unsigned char c)
 {
-    if (strstr(value, message->message_p1)
-        && (!message->message_p2 || strstr(value, message->message_p2))
-        && (!message->message_p3 || strstr(value, message->message_p3)))
-        return true;
-    return false;
+    struct borg_match_state *st;
+
+    if (borg_matcher.num_states == borg_matcher.alloc_states) {
+        borg_matcher.alloc_states = MAX(64, 2 * borg_matcher.alloc_states);
+        borg_matcher.states = mem_realloc(borg_matcher.states,
+            borg_matcher.alloc_states * sizeof(*borg_matcher.states));
+    }
+    st          = &borg_matcher.states[borg_matcher.num_states];
+    st->child   = 0;
+    st->sibling = 0;
+    st->fail    = 0;
+    st->dict    = 0;
+    st->pattern = -1;
+    st->c       = c;
+    if (parent == 0) {
+        borg_matcher.root[c] = borg_matcher.num_states;
+    } else {
+        st->sibling = borg_matcher.states[parent].child;
+        borg_matcher.states[parent].child = borg_matcher.num_states;
+    }
+    return borg_matcher.num_states++;
+}
+
+/* Find the child of a state for a character, 0 if there is none */
+static int borg_match_child(int state, unsigned char c)
+{
+    int child;
+
+    if (state == 0)
+        return borg_matcher.root[c];
+    for (child = borg_matcher.states[state].child; child;
+         child = borg_matcher.states[child].sibling) {
+        if (borg_matcher.states[child].c == c)
+            return child;
+    }
+    return 0;
+}
+
+/* Add a piece of text, returning its id; the same text gets the same id */
+static int borg_match_add_pattern(const char *text)
+{
+    int state = 0, id;
+    const unsigned char *t;
+
+    if (!borg_matcher.states)
+        borg_match_new_state(0, 0);
+
+    for (t = (const unsigned char *)text; *t; t++) {
+        int next = borg_match_child(state, *t);
+        if (!next)
+            next = borg_match_new_state(state, *t);
+        state = next;
+    }
+
+    if (state == 0 && borg_matcher.empty >= 0)
+        return borg_matcher.empty;
+    if (state && borg_matcher.states[state].pattern >= 0)
+        return borg_matcher.states[state].pattern;
+
+    if (borg_matcher.num_patterns == borg_matcher.alloc_patterns) {
+        borg_matcher.alloc_patterns = MAX(64, 2 * borg_matcher.alloc_patterns);
+        borg_matcher.len = mem_realloc(borg_matcher.len,
+            borg_matcher.alloc_patterns * sizeof(int));
+        borg_matcher.rules = mem_realloc(borg_matcher.rules,
+            borg_matcher.alloc_patterns * sizeof(int));
+    }
+    id                        = borg_matcher.num_patterns++;
+    borg_matcher.len[id]      = strlen(text);
+    borg_matcher.rules[id]    = -1;
+    if (state == 0)
+        borg_matcher.empty = id;
+    else
+        borg_matcher.states[state].pattern = id;
+    return id;
+}
+
+/* Note that a piece starts the given entry of a table */
+static void borg_match_add_rule(int id, int table, int entry)
+{
+    struct borg_match_rule *rule;
+
+    if (borg_matcher.num_rules == borg_matcher.alloc_rules) {
+        borg_matcher.alloc_rules = MAX(64, 2 * borg_matcher.alloc_rules);
+        borg_matcher.rule_list = mem_realloc(borg_matcher.rule_list,
+            borg_matcher.alloc_rules * sizeof(*borg_matcher.rule_list));
+    }
+    rule        = &borg_matcher.rule_list[borg_matcher.num_rules];
+    rule->table = table;
+    rule->entry = entry;
+    rule->next  = borg_matcher.rules[id];
+    borg_matcher.rules[id] = borg_matcher.num_rules++;
+}
+
+/* Work out the failure and dictionary links, breadth first */
+static void borg_match_link(void)
+{
+    int *queue = mem_alloc(borg_matcher.num_states * sizeof(int));
+    int  head = 0, tail = 0, c;
+
+    for (c = 0; c < 256; c++) {
+        if (borg_matcher.root[c])
+            queue[tail++] = borg_matcher.root[c];
+    }
+    while (head < tail) {
+        int state = queue[head++], child;
+
+        for (child = borg_matcher.states[state].child; child;
+             child = borg_matcher.states[child].sibling) {
+            struct borg_match_state *st = &borg_matcher.states[child];
+            int f = borg_matcher.states[state].fail;
+
+            while (f && !borg_match_child(f, st->c))
+                f = borg_matcher.states[f].fail;
+            st->fail = borg_match_child(f, st->c);
+            st->dict = (borg_matcher.states[st->fail].pattern >= 0)
+                           ? st->fail
+                           : borg_matcher.states[st->fail].dict;
+            queue[tail++] = child;
+        }
+    }
+    mem_free(queue);
+
+    borg_matcher.seen = mem_zalloc(borg_matcher.num_patterns * sizeof(uint32_t));
+    borg_matcher.at_end
+        = mem_zalloc(borg_matcher.num_patterns * sizeof(uint32_t));
+    borg_matcher.start = mem_zalloc(borg_matcher.num_patterns * sizeof(int));
+    borg_matcher.hits  = mem_zalloc(borg_matcher.num_patterns * sizeof(int));
+}
+
+/* Find all the pieces in a message in one pass */
+static void borg_match_scan(const char *msg)
+{
+    int state = 0, i, len = strlen(msg);
+
+    borg_matcher.stamp++;
+    borg_matcher.num_hits = 0;
+    if (!borg_matcher.states)
+        return;
+
+    for (i = 0; i < len; i++) {
+        unsigned char c = msg[i];
+        int s;
+
+        while (state && !borg_match_child(state, c))
+            state = borg_matcher.states[state].fail;
+        state = borg_match_child(state, c);
+
+        s = (borg_matcher.states[state].pattern >= 0)
+                ? state
+                : borg_matcher.states[state].dict;
+        for (; s; s = borg_matcher.states[s].dict) {
+            int id = borg_matcher.states[s].pattern;
+
+            if (borg_matcher.seen[id] != borg_matcher.stamp) {
+                borg_matcher.seen[id]  = borg_matcher.stamp;
+                borg_matcher.start[id] = i + 1 - borg_matcher.len[id];
+                borg_matcher.hits[borg_matcher.num_hits++] = id;
+            }
+            if (i == len - 1)
+                borg_matcher.at_end[id] = borg_matcher.stamp;
+        }
+    }
+}
+
+/* Is a piece in the last message scanned?  Missing pieces always are. */
+static bool borg_match_has(int id)
+{
+    return id < 0 || id == borg_matcher.empty
+           || borg_matcher.seen[id] == borg_matcher.stamp;
+}
+
+/* Check the other parts of a read message against the last scan */
+static bool borg_match_entry(struct borg_read_messages *msgs, int entry)
+{
+    struct borg_read_message *m = &msgs->messages[entry];
+
+    return borg_match_has(m->id_p2) && borg_match_has(m->id_p3);
+}
+
+/*
+ * Find the first entry of a table matching the last message scanned, or -1.
+ * Suffix tables need their piece to end the message; the others need all the
+ * parts of the entry to be somewhere in it.
+ */
+static int borg_match_first(int table, struct borg_read_messages *msgs)
+{
+    int best = -1, h, r;
+
+    for (h = -1; h < borg_matcher.num_hits; h++) {
+        int id = (h < 0) ? borg_matcher.empty : borg_matcher.hits[h];
+
+        if (id < 0)
+            continue;
+        if (!msgs && id != borg_matcher.empty
+            && borg_matcher.at_end[id] != borg_matcher.stamp)
+            continue;
+        for (r = borg_matcher.rules[id]; r >= 0;
+             r = borg_matcher.rule_list[r].next) {
+            struct borg_match_rule *rule = &borg_matcher.rule_list[r];
+
+            if (rule->table != table)
+                continue;
+            if (best >= 0 && rule->entry >= best)
+                continue;
+            if (msgs && !borg_match_entry(msgs, rule->entry))
+                continue;
+            best = rule->entry;
+        }
+    }
+    return best;
+}
+
+/* Where the first part of a table entry starts in the last message scanned */
+static int borg_match_start(struct borg_read_messages *msgs, int entry)
+{
+    int id = msgs->messages[entry].id_p1;
+
+    return (id == borg_matcher.empty) ? 0 : borg_matcher.start[id];
+}
+
+/* Give the pieces of every entry of a table to the matcher */
+static void borg_match_add_table(struct borg_read_messages *msgs, int table)
+{
+    int i;
+
+    for (i = 0; msgs->messages[i].message_p1; i++) {
+        struct borg_read_message *m = &msgs->messages[i];
+
+        m->id_p1 = borg_match_add_pattern(m->message_p1);
+        m->id_p2 = m->message_p2 ? borg_match_add_pattern(m->message_p2) : -1;
+        m->id_p3 = m->message_p3 ? borg_match_add_pattern(m->message_p3) : -1;
+        borg_match_add_rule(m->id_p1, table, i);
+    }
+}
+
+static void borg_match_free(void)
+{
+    mem_free(borg_matcher.states);
+    mem_free(borg_matcher.len);
+    mem_free(borg_matcher.rules);
+    mem_free(borg_matcher.seen);
+    mem_free(borg_matcher.at_end);
+    mem_free(borg_matcher.start);
+    mem_free(borg_matcher.rule_list);
+    mem_free(borg_matcher.hits);
+    memset(&borg_matcher, 0, sizeof(borg_matcher));
+    borg_matcher.empty = -1;
 }
 
 /*
@@ -404,16 +706,17 @@ static void borg_parse_aux(char *msg, int len)
             return;
         }
     } else {
+        /* Find all the monster-derived pieces in one pass */
+        borg_match_scan(msg);
+
         /* "It screams in pain." (etc) */
-        for (i = 0; suffix_pain[i]; i++) {
-            /* "It screams in pain." (etc) */
-            if (suffix(msg, suffix_pain[i])) {
-                tmp = strlen(suffix_pain[i]);
-                strnfmt(who, 1 + len - tmp, "%s", msg);
-                strnfmt(buf, 256, "PAIN:%s", who);
-                borg_react(msg, buf);
-                return;
-            }
+        i = borg_match_first(BORG_MATCH_PAIN, NULL);
+        if (i >= 0) {
+            tmp = strlen(suffix_pain[i]);
+            strnfmt(who, 1 + len - tmp, "%s", msg);
+            strnfmt(buf, 256, "PAIN:%s", who);
+            borg_react(msg, buf);
+            return;
         }
 
         /* "You have killed it." (etc) */
@@ -472,64 +775,56 @@ static void borg_parse_aux(char *msg, int len)
         }
 
         /* "It hits you." (etc) */
-        for (i = 0; suffix_hit_by.messages[i].message_p1; i++) {
-            /* "It hits you." (etc) */
-            if (borg_message_contains(msg, &suffix_hit_by.messages[i])) {
-                char *start = strstr(msg, suffix_hit_by.messages[i].message_p1);
-                if (start) {
-                    strnfmt(who, (start - msg), "%s", msg);
-                    strnfmt(buf, 256, "HIT_BY:%s", who);
-                    borg_react(msg, buf);
-
-                    /* If I was hit, then I am not on a glyph */
-                    if (track_glyph.num) {
-                        /* erase them all and
-                         * allow the borg to scan the screen and rebuild the
-                         * array. He won't see the one under him though.  So a
-                         * special check must be made.
-                         */
-                        /* Remove the entire array */
-                        for (i = 0; i < track_glyph.num; i++) {
-                            /* Stop if we already new about this glyph */
-                            track_glyph.x[i] = 0;
-                            track_glyph.y[i] = 0;
-                        }
-                        track_glyph.num = 0;
-
-                        /* Check for glyphs under player -- Cheat*/
-                        if (square_iswarded(cave, borg.c)) {
-                            track_glyph.x[track_glyph.num] = borg.c.x;
-                            track_glyph.y[track_glyph.num] = borg.c.y;
-                            track_glyph.num++;
-                        }
-                    }
-                    return;
+        i = borg_match_first(BORG_MATCH_HIT_BY, &suffix_hit_by);
+        if (i >= 0) {
+            char *start = msg + borg_match_start(&suffix_hit_by, i);
+
+            strnfmt(who, (start - msg), "%s", msg);
+            strnfmt(buf, 256, "HIT_BY:%s", who);
+            borg_react(msg, buf);
+
+            /* If I was hit, then I am not on a glyph */
+            if (track_glyph.num) {
+                /* erase them all and
+                 * allow the borg to scan the screen and rebuild the
+                 * array. He won't see the one under him though.  So a
+                 * special check must be made.
+                 */
+                /* Remove the entire array */
+                for (i = 0; i < track_glyph.num; i++) {
+                    /* Stop if we already new about this glyph */
+                    track_glyph.x[i] = 0;
+                    track_glyph.y[i] = 0;
+                }
+                track_glyph.num = 0;
+
+                /* Check for glyphs under player -- Cheat*/
+                if (square_iswarded(cave, borg.c)) {
+                    track_glyph.x[track_glyph.num] = borg.c.x;
+                    track_glyph.y[track_glyph.num] = borg.c.y;
+                    track_glyph.num++;
                 }
             }
+            return;
         }
 
-        for (i = 0; spell_invis_msgs.messages[i].message_p1; i++) {
-            /* get rid of the messages that aren't for invisible spells */
-            if (!prefix(msg, "Something ") && !prefix(msg, "You "))
-                break;
-            if (borg_message_contains(msg, &spell_invis_msgs.messages[i])) {
+        /* get rid of the messages that aren't for invisible spells */
+        if (prefix(msg, "Something ") || prefix(msg, "You ")) {
+            i = borg_match_first(BORG_MATCH_SPELL_INVIS, &spell_invis_msgs);
+            if (i >= 0) {
                 strnfmt(buf, 256, "SPELL_%03d:%s", spell_invis_msgs.index[i],
                     "Something");
                 borg_react(msg, buf);
                 return;
             }
         }
-        for (i = 0; spell_msgs.messages[i].message_p1; i++) {
-            if (borg_message_contains(msg, &spell_msgs.messages[i])) {
-                char *start = strstr(msg, spell_msgs.messages[i].message_p1);
-                if (start) {
-                    strnfmt(who, (start - msg), "%s", msg);
-                    strnfmt(
-                        buf, 256, "SPELL_%03d:%s", spell_msgs.index[i], who);
-                    borg_react(msg, buf);
-                    return;
-                }
-            }
+        i = borg_match_first(BORG_MATCH_SPELL, &spell_msgs);
+        if (i >= 0) {
+            char *start = msg + borg_match_start(&spell_msgs, i);
+            strnfmt(who, (start - msg), "%s", msg);
+            strnfmt(buf, 256, "SPELL_%03d:%s", spell_msgs.index[i], who);
+            borg_react(msg, buf);
+            return;
         }
 
         /* State -- Asleep */
@@ -1602,12 +1897,28 @@ static void borg_init_hit_by_messages(void)
     insert_msg(&suffix_hit_by, NULL, 0);
 }
 
+/* compile the pain, hit by and spell messages into the matcher */
+static void borg_init_matcher(void)
+{
+    int i;
+
+    borg_match_free();
+    for (i = 0; suffix_pain[i]; i++)
+        borg_match_add_rule(
+            borg_match_add_pattern(suffix_pain[i]), BORG_MATCH_PAIN, i);
+    borg_match_add_table(&suffix_hit_by, BORG_MATCH_HIT_BY);
+    borg_match_add_table(&spell_invis_msgs, BORG_MATCH_SPELL_INVIS);
+    borg_match_add_table(&spell_msgs, BORG_MATCH_SPELL);
+    borg_match_link();
+}
+
 /* init all messages used by the borg */
 void borg_init_messages(void)
 {
     borg_init_spell_messages();
     borg_init_pain_messages();
     borg_init_hit_by_messages();
+    borg_init_matcher();
 
     /*** Message tracking ***/
 
@@ -1658,6 +1969,7 @@ void borg_free_messages(void)
     clean_msgs(&suffix_hit_by);
     clean_msgs(&spell_invis_msgs);
     clean_msgs(&spell_msgs);
+    borg_match_free();
 }
 
 #endif
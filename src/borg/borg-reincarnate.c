@@ -551,7 +551,7 @@ void reincarnate_borg(void)
     /* Now only randomize the artifacts if required */
     if (OPT(player, birth_randarts)) {
         seed_randart = randint0(0x10000000);
-        do_randart(seed_randart, true);
+        do_randart(seed_randart, true, false);
         deactivate_randart_file();
     }
 
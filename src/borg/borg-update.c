@@ -112,6 +112,125 @@ static int o_w_y = -1;
 /* Old location */
 static struct loc old_c = { -1, -1 };
 
+/*
+ * The observation feed
+ *
+ * Rather than rescanning the whole map panel every update, the borg listens
+ * to the game's map, monster and object events and only looks again at the
+ * grids they name.  The monsters and objects seen on the panel are kept per
+ * grid so the tracking list can be rebuilt without a scan.  The whole panel
+ * is still scanned when the panel moves, when something the scan depends on
+ * changes, when too many grids change at once and every so often in case
+ * the game changed something quietly.
+ */
+#define BORG_FEED_DIRTY_MAX 1024
+#define BORG_FEED_REFRESH   50
+
+static struct {
+    bool        full;      /* rescan the whole panel next update */
+    int         w_x, w_y;  /* panel of the last full scan */
+    int         hgt, wid;  /* size of that panel */
+    int         key;       /* borg state that scan depended on */
+    int         age;       /* updates since that scan */
+
+    struct loc *dirty;     /* grids changed since the last update */
+    int         num_dirty;
+    bool       *is_dirty;  /* AUTO_MAX_Y * AUTO_MAX_X */
+
+    borg_wank  *seen;      /* monster/object last seen, per grid */
+    struct loc *seen_list; /* grids with something in "seen" */
+    int         num_seen;
+    int        *seen_pos;  /* 1 + index into "seen_list", 0 for none */
+} borg_feed;
+
+/* Note that a grid needs looking at again */
+static void borg_feed_mark(struct loc grid)
+{
+    int n;
+
+    if (grid.x < 0 || grid.y < 0 || grid.x >= AUTO_MAX_X
+        || grid.y >= AUTO_MAX_Y) {
+        borg_feed.full = true;
+        return;
+    }
+    n = grid.y * AUTO_MAX_X + grid.x;
+    if (borg_feed.is_dirty[n])
+        return;
+    if (borg_feed.num_dirty == BORG_FEED_DIRTY_MAX) {
+        borg_feed.full = true;
+        return;
+    }
+    borg_feed.is_dirty[n]                  = true;
+    borg_feed.dirty[borg_feed.num_dirty++] = grid;
+}
+
+/* Some grid (or, for (-1, -1), the whole map) has changed */
+static void borg_feed_map(
+    game_event_type type, game_event_data *data, void *user)
+{
+    borg_feed_mark(data->point);
+}
+
+/* A monster appeared, disappeared or moved */
+static void borg_feed_monster(
+    game_event_type type, game_event_data *data, void *user)
+{
+    borg_feed_mark(data->monster.grid);
+    borg_feed_mark(data->monster.from);
+}
+
+/* The whole level has changed */
+static void borg_feed_level(
+    game_event_type type, game_event_data *data, void *user)
+{
+    borg_feed.full = true;
+}
+
+/* Forget anything seen on a grid */
+static void borg_forget_seen(int x, int y)
+{
+    int n = y * AUTO_MAX_X + x, i = borg_feed.seen_pos[n] - 1;
+    struct loc last;
+
+    if (i < 0)
+        return;
+    last                   = borg_feed.seen_list[--borg_feed.num_seen];
+    borg_feed.seen_list[i] = last;
+    borg_feed.seen_pos[last.y * AUTO_MAX_X + last.x] = i + 1;
+    borg_feed.seen_pos[n]  = 0;
+}
+
+/* Start remembering what is seen on a grid */
+static borg_wank *borg_note_seen(int x, int y)
+{
+    static borg_wank junk;
+    int              n = y * AUTO_MAX_X + x;
+
+    /* Check for memory overflow */
+    if (borg_feed.num_seen == AUTO_VIEW_MAX) {
+        borg_note(format("# Wank problem at grid (%d,%d), borg at (%d,%d)", y,
+            x, borg.c.y, borg.c.x));
+        borg_oops("too many objects...");
+        return &junk;
+    }
+
+    borg_feed.seen_list[borg_feed.num_seen++] = loc(x, y);
+    borg_feed.seen_pos[n]                     = borg_feed.num_seen;
+    borg_feed.seen[n].x                       = x;
+    borg_feed.seen[n].y                       = y;
+    return &borg_feed.seen[n];
+}
+
+/* Order tracking grids as a scan of the panel would find them */
+static int borg_cmp_wank(const void *a, const void *b)
+{
+    const borg_wank *wa = a, *wb = b;
+
+    if (wa->y != wb->y)
+        return wa->y - wb->y;
+    return wa->x - wb->x;
+}
+
 /*
  * Update the Borg based on the current "map"
  */
@@ -164,6 +283,9 @@ static void borg_forget_map(void)
 
     /* Forget the view */
     borg_forget_view();
+
+    /* Look at everything again */
+    borg_feed.full = true;
 }
 
 /*
@@ -251,353 +373,397 @@ static void borg_forget_map(void)
  * which was thought to be something else, like an unknown grid.
  *
  */
-static void borg_update_map(void)
+/*
+ * Update one grid of the "map" from the screen
+ */
+static void borg_update_map_grid(struct loc l)
 {
-    int i, x, y, dx, dy;
+    int x = l.x, y = l.y, i;
 
     borg_grid       *ag;
     struct grid_data g;
 
-    /* Analyze the current map panel */
-    for (dy = 0; dy < SCREEN_HGT; dy++) {
-        /* Scan the row */
-        for (dx = 0; dx < SCREEN_WID; dx++) {
-            bool old_wall;
-            bool new_wall;
-
-            /* Obtain the map location */
-            x = w_x + dx;
-            y = w_y + dy;
-
-            /* Cheat the exact information from the screen */
-            struct loc l = loc(x, y);
-            /* since the map is now dynamically sized, double check we are in
-             * bounds */
-            if (!square_in_bounds(cave, l))
-                continue;
-            map_info(l, &g);
+    bool old_wall;
+    bool new_wall;
 
-            /* Get the borg_grid */
-            ag = &borg_grids[y][x];
+    /* Cheat the exact information from the screen */
+    map_info(l, &g);
 
-            /* Notice "on-screen" */
-            ag->info |= BORG_OKAY;
-
-            /* Notice "knowledge" */
-            /* if this square is not in view and the borg previously */
-            /* cast stone to mud here, ignore the map info so repeated */
-            /* stone to mud aren't cast */
-            if (g.f_idx != FEAT_NONE
-                && (g.in_view || !(ag->info & BORG_IGNORE_MAP))) {
-                if (g.in_view) {
-                    ag->info &= ~BORG_IGNORE_MAP;
-                }
-                ag->info |= BORG_MARK;
-                ag->feat = g.f_idx;
-            }
+    /* Forget what used to be here */
+    borg_forget_seen(x, y);
 
-            /* default store to - 1 */
-            ag->store = -1;
+    /* Get the borg_grid */
+    ag = &borg_grids[y][x];
 
-            /* Notice the player */
-            if (g.is_player) {
-                /* Memorize player location */
-                borg.c.x = x;
-                borg.c.y = y;
-            }
+    /* Notice "on-screen" */
+    ag->info |= BORG_OKAY;
 
-            /* Save the old "wall" or "door" */
-            old_wall = !borg_cave_floor_grid(ag);
+    /* Notice "knowledge" */
+    /* if this square is not in view and the borg previously */
+    /* cast stone to mud here, ignore the map info so repeated */
+    /* stone to mud aren't cast */
+    if (g.f_idx != FEAT_NONE
+        && (g.in_view || !(ag->info & BORG_IGNORE_MAP))) {
+        if (g.in_view) {
+            ag->info &= ~BORG_IGNORE_MAP;
+        }
+        ag->info |= BORG_MARK;
+        ag->feat = g.f_idx;
+    }
 
-            /* Analyze know information about grid */
-            /* Shop Doors */
-            if (feat_is_shop(g.f_idx)) {
-                /* Shop type */
-                ag->feat  = g.f_idx;
+    /* default store to - 1 */
+    ag->store = -1;
 
-                i         = square_shopnum(cave, l);
-                ag->store = i;
+    /* Notice the player */
+    if (g.is_player) {
+        /* Memorize player location */
+        borg.c.x = x;
+        borg.c.y = y;
+    }
 
-                /* Save new information */
-                track_shop_x[i] = x;
-                track_shop_y[i] = y;
+    /* Save the old "wall" or "door" */
+    old_wall = !borg_cave_floor_grid(ag);
 
-            } else if (square_isdisarmabletrap(cave, l)) {
-                /* Minor cheat for the borg.  If the borg is running
-                 * in the graphics mode (not the AdamBolt Tiles) he will
-                 * mis-id the glyph of warding as a trap
-                 */
-                ag->trap      = true;
-                uint8_t t_idx = square(cave, l)->trap->t_idx;
-                if (trf_has(trap_info[t_idx].flags, TRF_GLYPH)) {
-                    ag->glyph = true;
-                    /* Check for an existing glyph */
-                    for (i = 0; i < track_glyph.num; i++) {
-                        /* Stop if we already new about this glyph */
-                        if ((track_glyph.x[i] == x) && (track_glyph.y[i] == y))
-                            break;
-                    }
-
-                    /* Track the newly discovered glyph */
-                    if ((i == track_glyph.num) && (i < track_glyph.size)) {
-                        track_glyph.x[i] = x;
-                        track_glyph.y[i] = y;
-                        track_glyph.num++;
-                    }
-                }
+    /* Analyze know information about grid */
+    /* Shop Doors */
+    if (feat_is_shop(g.f_idx)) {
+        /* Shop type */
+        ag->feat  = g.f_idx;
+
+        i         = square_shopnum(cave, l);
+        ag->store = i;
+
+        /* Save new information */
+        track_shop_x[i] = x;
+        track_shop_y[i] = y;
+
+    } else if (square_isdisarmabletrap(cave, l)) {
+        /* Minor cheat for the borg.  If the borg is running
+         * in the graphics mode (not the AdamBolt Tiles) he will
+         * mis-id the glyph of warding as a trap
+         */
+        ag->trap      = true;
+        uint8_t t_idx = square(cave, l)->trap->t_idx;
+        if (trf_has(trap_info[t_idx].flags, TRF_GLYPH)) {
+            ag->glyph = true;
+            /* Check for an existing glyph */
+            for (i = 0; i < track_glyph.num; i++) {
+                /* Stop if we already new about this glyph */
+                if ((track_glyph.x[i] == x) && (track_glyph.y[i] == y))
+                    break;
             }
-            /* Darkness */
-            else if (g.f_idx == FEAT_NONE) {
-                /* The grid is not lit */
-                ag->info &= ~BORG_GLOW;
-
-                /* Known grids must be dark floors */
-                if (ag->feat != FEAT_NONE)
-                    ag->info |= BORG_DARK;
+
+            /* Track the newly discovered glyph */
+            if ((i == track_glyph.num) && (i < track_glyph.size)) {
+                track_glyph.x[i] = x;
+                track_glyph.y[i] = y;
+                track_glyph.num++;
             }
-            /* Floors */
-            else if (g.f_idx == FEAT_NONE) {
-                /* Handle "blind" */
-                if (borg.trait[BI_ISBLIND]) {
-                    /* Nothing */
-                }
+        }
+    }
+    /* Darkness */
+    else if (g.f_idx == FEAT_NONE) {
+        /* The grid is not lit */
+        ag->info &= ~BORG_GLOW;
+
+        /* Known grids must be dark floors */
+        if (ag->feat != FEAT_NONE)
+            ag->info |= BORG_DARK;
+    }
+    /* Floors */
+    else if (g.f_idx == FEAT_NONE) {
+        /* Handle "blind" */
+        if (borg.trait[BI_ISBLIND]) {
+            /* Nothing */
+        }
 
-                /* Handle "dark" floors */
-                if (g.lighting == LIGHTING_DARK) {
-                    /* Dark floor grid */
-                    ag->info |= BORG_DARK;
-                    ag->info &= ~BORG_GLOW;
-                }
+        /* Handle "dark" floors */
+        if (g.lighting == LIGHTING_DARK) {
+            /* Dark floor grid */
+            ag->info |= BORG_DARK;
+            ag->info &= ~BORG_GLOW;
+        }
 
-                /* Handle Glowing floors */
-                else if (g.lighting == LIGHTING_LIT) {
-                    /* Perma Glowing Grid */
-                    ag->info |= BORG_GLOW;
+        /* Handle Glowing floors */
+        else if (g.lighting == LIGHTING_LIT) {
+            /* Perma Glowing Grid */
+            ag->info |= BORG_GLOW;
 
-                    /* Assume not dark */
-                    ag->info &= ~BORG_DARK;
-                }
+            /* Assume not dark */
+            ag->info &= ~BORG_DARK;
+        }
 
-                /* torch-lit or line of sight grids */
-                else {
-                    ag->info |= BORG_LIGHT;
+        /* torch-lit or line of sight grids */
+        else {
+            ag->info |= BORG_LIGHT;
 
-                    /* Assume not dark */
-                    ag->info &= ~BORG_DARK;
-                }
-            }
-            /* Open doors */
-            else if (g.f_idx == FEAT_OPEN || g.f_idx == FEAT_BROKEN) {
-            }
-            /* Walls */
-            else if (g.f_idx == FEAT_GRANITE || g.f_idx == FEAT_PERM) {
-                /* ok this is a humongo cheat.  He is pulling the
-                 * grid information from the game rather than from
-                 * his memory.  He is going to see if the wall is perm.
-                 * This is a cheat. May the Lord have mercy on my soul.
-                 *
-                 * The only other option is to have him "dig" on each
-                 * and every granite wall to see if it is perm.  Then he
-                 * can mark it as a non-perm.  However, he would only have
-                 * to dig once and only in a range of spaces near the
-                 * center of the map.  Since perma-walls are located in
-                 * vaults and vaults have a minimum size.  So he can avoid
-                 * digging on walls that are, say, 10 spaces from the edge
-                 * of the map.  He can also limit the dig by his depth.
-                 * Vaults are found below certain levels and with certain
-                 * "feelings."  Can be told not to dig on boring levels
-                 * and not before level 50 or whatever.
-                 *
-                 * Since the code to dig slows the borg down a lot.
-                 * (Found in borg6.c in _flow_dark_interesting()) We will
-                 * limit his capacity to search.  We will set a flag on
-                 * the level is perma grids are found.
-                 */
-                /* is it a perma grid?  Only counts for being a vault if not in
-                 * town */
-                /* and not on edge of map */
-                if (ag->feat == FEAT_PERM && borg.trait[BI_CDEPTH] && x && y
-                    && x != (cave->width - 1) && y != (cave->height - 1)) {
-                    vault_on_level = true;
-                }
-            }
-            /* lava */
-            else if (g.f_idx == FEAT_LAVA) {
+            /* Assume not dark */
+            ag->info &= ~BORG_DARK;
+        }
+    }
+    /* Open doors */
+    else if (g.f_idx == FEAT_OPEN || g.f_idx == FEAT_BROKEN) {
+    }
+    /* Walls */
+    else if (g.f_idx == FEAT_GRANITE || g.f_idx == FEAT_PERM) {
+        /* ok this is a humongo cheat.  He is pulling the
+         * grid information from the game rather than from
+         * his memory.  He is going to see if the wall is perm.
+         * This is a cheat. May the Lord have mercy on my soul.
+         *
+         * The only other option is to have him "dig" on each
+         * and every granite wall to see if it is perm.  Then he
+         * can mark it as a non-perm.  However, he would only have
+         * to dig once and only in a range of spaces near the
+         * center of the map.  Since perma-walls are located in
+         * vaults and vaults have a minimum size.  So he can avoid
+         * digging on walls that are, say, 10 spaces from the edge
+         * of the map.  He can also limit the dig by his depth.
+         * Vaults are found below certain levels and with certain
+         * "feelings."  Can be told not to dig on boring levels
+         * and not before level 50 or whatever.
+         *
+         * Since the code to dig slows the borg down a lot.
+         * (Found in borg6.c in _flow_dark_interesting()) We will
+         * limit his capacity to search.  We will set a flag on
+         * the level is perma grids are found.
+         */
+        /* is it a perma grid?  Only counts for being a vault if not in
+         * town */
+        /* and not on edge of map */
+        if (ag->feat == FEAT_PERM && borg.trait[BI_CDEPTH] && x && y
+            && x != (cave->width - 1) && y != (cave->height - 1)) {
+            vault_on_level = true;
+        }
+    }
+    /* lava */
+    else if (g.f_idx == FEAT_LAVA) {
+    }
+    /* Seams and rubble */
+    else if (g.f_idx == FEAT_MAGMA || g.f_idx == FEAT_QUARTZ
+             || g.f_idx == FEAT_RUBBLE) {
+        /* If we are twitching around unable to go anywhere, count */
+        /* regular veins as worth digging out */
+        if (borg.times_twitch > 21) {
+            /* but only quartz if we can dig it */
+            if (!borg_can_dig(true, FEAT_QUARTZ_K) && g.f_idx == FEAT_QUARTZ)
+                return;
+
+            /* Check for an existing vein */
+            for (i = 0; i < track_vein.num; i++) {
+                /* Stop if we already new about this */
+                if ((track_vein.x[i] == x) && (track_vein.y[i] == y))
+                    break;
             }
-            /* Seams and rubble */
-            else if (g.f_idx == FEAT_MAGMA || g.f_idx == FEAT_QUARTZ
-                     || g.f_idx == FEAT_RUBBLE) {
-                /* If we are twitching around unable to go anywhere, count */
-                /* regular veins as worth digging out */
-                if (borg.times_twitch > 21) {
-                    /* but only quartz if we can dig it */
-                    if (!borg_can_dig(true, FEAT_QUARTZ_K) && g.f_idx == FEAT_QUARTZ)
-                        continue;
 
-                    /* Check for an existing vein */
-                    for (i = 0; i < track_vein.num; i++) {
-                        /* Stop if we already new about this */
-                        if ((track_vein.x[i] == x) && (track_vein.y[i] == y))
-                            break;
-                    }
-
-                    /* Track the newly discovered vein */
-                    if ((i == track_vein.num) && (i < track_vein.size)) {
-                        track_vein.x[i] = x;
-                        track_vein.y[i] = y;
-                        track_vein.num++;
-
-                        /* do not overflow */
-                        if (track_vein.num > 99)
-                            track_vein.num = 99;
-                    }
-                }
+            /* Track the newly discovered vein */
+            if ((i == track_vein.num) && (i < track_vein.size)) {
+                track_vein.x[i] = x;
+                track_vein.y[i] = y;
+                track_vein.num++;
+
+                /* do not overflow */
+                if (track_vein.num > 99)
+                    track_vein.num = 99;
             }
-            /* Hidden */
-            else if (g.f_idx == FEAT_MAGMA_K || g.f_idx == FEAT_QUARTZ_K) {
-                /* Check for an existing vein */
-                for (i = 0; i < track_vein.num; i++) {
-                    /* Stop if we already new about this */
-                    if ((track_vein.x[i] == x) && (track_vein.y[i] == y))
-                        break;
-                }
+        }
+    }
+    /* Hidden */
+    else if (g.f_idx == FEAT_MAGMA_K || g.f_idx == FEAT_QUARTZ_K) {
+        /* Check for an existing vein */
+        for (i = 0; i < track_vein.num; i++) {
+            /* Stop if we already new about this */
+            if ((track_vein.x[i] == x) && (track_vein.y[i] == y))
+                break;
+        }
 
-                /* Track the newly discovered vein */
-                if ((i == track_vein.num) && (i < track_vein.size)) {
-                    track_vein.x[i] = x;
-                    track_vein.y[i] = y;
-                    track_vein.num++;
+        /* Track the newly discovered vein */
+        if ((i == track_vein.num) && (i < track_vein.size)) {
+            track_vein.x[i] = x;
+            track_vein.y[i] = y;
+            track_vein.num++;
 
-                    /* do not overflow */
-                    if (track_vein.num > 99)
-                        track_vein.num = 99;
-                }
-            }
-            /* Doors */
-            else if (g.f_idx == FEAT_CLOSED) {
-                /* Only while low level */
-                if (borg.trait[BI_CLEVEL] <= 5) {
-                    /* Check for an existing door */
-                    for (i = 0; i < track_closed.num; i++) {
-                        /* Stop if we already new about this door */
-                        if ((track_closed.x[i] == x)
-                            && (track_closed.y[i] == y))
-                            break;
-                    }
-
-                    /* Track the newly discovered door */
-                    if ((i == track_closed.num) && (i < track_closed.size)) {
-                        track_closed.x[i] = x;
-                        track_closed.y[i] = y;
-                        track_closed.num++;
-
-                        /* do not overflow */
-                        if (track_closed.num > 254)
-                            track_closed.num = 254;
-                    }
-                }
+            /* do not overflow */
+            if (track_vein.num > 99)
+                track_vein.num = 99;
+        }
+    }
+    /* Doors */
+    else if (g.f_idx == FEAT_CLOSED) {
+        /* Only while low level */
+        if (borg.trait[BI_CLEVEL] <= 5) {
+            /* Check for an existing door */
+            for (i = 0; i < track_closed.num; i++) {
+                /* Stop if we already new about this door */
+                if ((track_closed.x[i] == x)
+                    && (track_closed.y[i] == y))
+                    break;
             }
-            /* Up stairs */
-            else if (g.f_idx == FEAT_LESS) {
-                /* Check for an existing "up stairs" */
-                for (i = 0; i < track_less.num; i++) {
-                    /* Stop if we already new about these stairs */
-                    if ((track_less.x[i] == x) && (track_less.y[i] == y))
-                        break;
-                }
 
-                /* Track the newly discovered "up stairs" */
-                if ((i == track_less.num) && (i < track_less.size)) {
-                    track_less.x[i] = x;
-                    track_less.y[i] = y;
-                    track_less.num++;
-                }
-            }
-            /* Down stairs */
-            else if (g.f_idx == FEAT_MORE) {
-                /* Check for an existing "down stairs" */
-                for (i = 0; i < track_more.num; i++) {
-                    /* We already knew about that one */
-                    if ((track_more.x[i] == x) && (track_more.y[i] == y))
-                        break;
-                }
+            /* Track the newly discovered door */
+            if ((i == track_closed.num) && (i < track_closed.size)) {
+                track_closed.x[i] = x;
+                track_closed.y[i] = y;
+                track_closed.num++;
 
-                /* Track the newly discovered "down stairs" */
-                if ((i == track_more.num) && (i < track_more.size)) {
-                    track_more.x[i] = x;
-                    track_more.y[i] = y;
-                    track_more.num++;
-                }
+                /* do not overflow */
+                if (track_closed.num > 254)
+                    track_closed.num = 254;
             }
+        }
+    }
+    /* Up stairs */
+    else if (g.f_idx == FEAT_LESS) {
+        /* Check for an existing "up stairs" */
+        for (i = 0; i < track_less.num; i++) {
+            /* Stop if we already new about these stairs */
+            if ((track_less.x[i] == x) && (track_less.y[i] == y))
+                break;
+        }
 
-            if (ag->feat == FEAT_FLOOR && square_iswebbed(cave, l)) {
-                ag->web = true;
-            } else
-                ag->web = false;          
-
-            /* Now do non-feature stuff */
-            if ((g.first_kind || g.m_idx) && !borg.trait[BI_ISIMAGE]) {
-                /* Monsters/Objects */
-                borg_wank *wank;
-
-                /* Check for memory overflow */
-                if (borg_wank_num == AUTO_VIEW_MAX) {
-                    borg_note(format("# Wank problem at grid (%d,%d) m:%lu "
-                                     "o:%lu, borg at (%d,%d)",
-                        y, x, (unsigned long)g.m_idx,
-                        (unsigned long)(g.first_kind ? g.first_kind->kidx : 0),
-                        borg.c.y, borg.c.x));
-                    borg_oops("too many objects...");
-                }
+        /* Track the newly discovered "up stairs" */
+        if ((i == track_less.num) && (i < track_less.size)) {
+            track_less.x[i] = x;
+            track_less.y[i] = y;
+            track_less.num++;
+        }
+    }
+    /* Down stairs */
+    else if (g.f_idx == FEAT_MORE) {
+        /* Check for an existing "down stairs" */
+        for (i = 0; i < track_more.num; i++) {
+            /* We already knew about that one */
+            if ((track_more.x[i] == x) && (track_more.y[i] == y))
+                break;
+        }
 
-                /* Access next wank, advance */
-                wank = &borg_wanks[borg_wank_num++];
-
-                /* Save some information */
-                wank->x = x;
-                wank->y = y;
-                /* monster symbol takes priority */
-                /* TODO: Store known information about monster/object, instead
-                 * of just the screen character */
-                if (g.m_idx) {
-                    struct monster *m_ptr = cave_monster(cave, g.m_idx);
-                    wank->t_a             = m_ptr->attr;
-                    wank->t_c             = r_info[m_ptr->race->ridx].d_char;
-                } else {
-                    wank->t_a = g.first_kind->d_attr;
-                    wank->t_c = g.first_kind->d_char;
-                }
-                wank->is_take = (g.first_kind != NULL);
-                wank->is_kill = (g.m_idx != 0);
-            }
+        /* Track the newly discovered "down stairs" */
+        if ((i == track_more.num) && (i < track_more.size)) {
+            track_more.x[i] = x;
+            track_more.y[i] = y;
+            track_more.num++;
+        }
+    }
+
+    if (ag->feat == FEAT_FLOOR && square_iswebbed(cave, l)) {
+        ag->web = true;
+    } else
+        ag->web = false;          
+
+    /* Now do non-feature stuff */
+    if ((g.first_kind || g.m_idx) && !borg.trait[BI_ISIMAGE]) {
+        /* Monsters/Objects */
+        borg_wank *wank = borg_note_seen(x, y);
+
+        /* monster symbol takes priority */
+        /* TODO: Store known information about monster/object, instead
+         * of just the screen character */
+        if (g.m_idx) {
+            struct monster *m_ptr = cave_monster(cave, g.m_idx);
+            wank->t_a             = m_ptr->attr;
+            wank->t_c             = r_info[m_ptr->race->ridx].d_char;
+        } else {
+            wank->t_a = g.first_kind->d_attr;
+            wank->t_c = g.first_kind->d_char;
+        }
+        wank->is_take = (g.first_kind != NULL);
+        wank->is_kill = (g.m_idx != 0);
+    }
 
-            /* Save the new "wall" or "door" */
-            new_wall = !borg_cave_floor_grid(ag);
+    /* Save the new "wall" or "door" */
+    new_wall = !borg_cave_floor_grid(ag);
 
-            /* Notice wall changes */
-            if (old_wall != new_wall) {
-                /* Remove this grid from any flow */
-                if (new_wall)
-                    borg_data_flow->data[y][x] = 255;
+    /* Notice wall changes */
+    if (old_wall != new_wall) {
+        /* Remove this grid from any flow */
+        if (new_wall)
+            borg_data_flow->data[y][x] = 255;
 
-                /* Remove this grid from any flow */
-                borg_data_know->data[y][x] = false;
+        /* Remove this grid from any flow */
+        borg_data_know->data[y][x] = false;
 
-                /* Remove this grid from any flow */
-                borg_data_icky->data[y][x] = false;
+        /* Remove this grid from any flow */
+        borg_data_icky->data[y][x] = false;
 
-                /* Recalculate the view (if needed) */
-                if (ag->info & BORG_VIEW)
-                    borg_do_update_view = true;
+        /* Recalculate the view (if needed) */
+        if (ag->info & BORG_VIEW)
+            borg_do_update_view = true;
 
-                /* Recalculate the lite (if needed) */
-                if (ag->info & BORG_LIGHT)
-                    borg_do_update_lite = true;
+        /* Recalculate the lite (if needed) */
+        if (ag->info & BORG_LIGHT)
+            borg_do_update_lite = true;
+    }
+}
+
+static void borg_update_map(void)
+{
+    int i, dx, dy, key;
+
+    /* Things which change what a scan finds without changing the map */
+    key = (borg.trait[BI_ISIMAGE] ? 1 : 0) | ((borg.times_twitch > 21) << 1)
+          | ((borg.trait[BI_CLEVEL] <= 5) << 2) | (borg.trait[BI_CDEPTH] << 3);
+
+    if (w_x != borg_feed.w_x || w_y != borg_feed.w_y
+        || SCREEN_HGT != borg_feed.hgt || SCREEN_WID != borg_feed.wid
+        || key != borg_feed.key || ++borg_feed.age >= BORG_FEED_REFRESH)
+        borg_feed.full = true;
+
+    if (borg_feed.full) {
+        /* Forget what was seen */
+        for (i = 0; i < borg_feed.num_seen; i++) {
+            struct loc l = borg_feed.seen_list[i];
+            borg_feed.seen_pos[l.y * AUTO_MAX_X + l.x] = 0;
+        }
+        borg_feed.num_seen = 0;
+
+        /* Analyze the current map panel */
+        for (dy = 0; dy < SCREEN_HGT; dy++) {
+            for (dx = 0; dx < SCREEN_WID; dx++) {
+                struct loc l = loc(w_x + dx, w_y + dy);
+
+                /* since the map is now dynamically sized, double check we
+                 * are in bounds */
+                if (square_in_bounds(cave, l))
+                    borg_update_map_grid(l);
             }
         }
+
+        borg_feed.full = false;
+        borg_feed.w_x  = w_x;
+        borg_feed.w_y  = w_y;
+        borg_feed.hgt  = SCREEN_HGT;
+        borg_feed.wid  = SCREEN_WID;
+        borg_feed.key  = key;
+        borg_feed.age  = 0;
+    } else {
+        /* Only look at the grids the game says have changed */
+        for (i = 0; i < borg_feed.num_dirty; i++) {
+            struct loc l = borg_feed.dirty[i];
+
+            if (l.x < w_x || l.y < w_y || l.x >= w_x + SCREEN_WID
+                || l.y >= w_y + SCREEN_HGT || !square_in_bounds(cave, l))
+                continue;
+            borg_update_map_grid(l);
+        }
+    }
+
+    /* Everything is up to date */
+    for (i = 0; i < borg_feed.num_dirty; i++) {
+        struct loc l = borg_feed.dirty[i];
+        borg_feed.is_dirty[l.y * AUTO_MAX_X + l.x] = false;
+    }
+    borg_feed.num_dirty = 0;
+
+    /* Rebuild the tracking list */
+    for (i = 0; i < borg_feed.num_seen; i++) {
+        struct loc l = borg_feed.seen_list[i];
+        borg_wanks[i] = borg_feed.seen[l.y * AUTO_MAX_X + l.x];
     }
+    borg_wank_num = borg_feed.num_seen;
+    qsort(borg_wanks, borg_wank_num, sizeof(borg_wank), borg_cmp_wank);
 }
 
+
 /*
  * Increase the "grid danger" from lots of monsters
  *   ###################
@@ -3092,6 +3258,18 @@ void borg_init_update(void)
     /* Array of "wanks" */
     borg_wanks = mem_zalloc(AUTO_VIEW_MAX * sizeof(borg_wank));
 
+    /* The observation feed */
+    borg_feed.dirty = mem_zalloc(BORG_FEED_DIRTY_MAX * sizeof(struct loc));
+    borg_feed.is_dirty = mem_zalloc(AUTO_MAX_Y * AUTO_MAX_X * sizeof(bool));
+    borg_feed.seen = mem_zalloc(AUTO_MAX_Y * AUTO_MAX_X * sizeof(borg_wank));
+    borg_feed.seen_list = mem_zalloc(AUTO_VIEW_MAX * sizeof(struct loc));
+    borg_feed.seen_pos  = mem_zalloc(AUTO_MAX_Y * AUTO_MAX_X * sizeof(int));
+    event_add_handler(EVENT_MAP, borg_feed_map, NULL);
+    event_add_handler(EVENT_OBJECT_SEEN, borg_feed_map, NULL);
+    event_add_handler(EVENT_MONSTER_SEEN, borg_feed_monster, NULL);
+    event_add_handler(EVENT_MONSTER_MOVED, borg_feed_monster, NULL);
+    event_add_handler(EVENT_NEW_LEVEL_DISPLAY, borg_feed_level, NULL);
+
     /*** Reset the map ***/
 
     /* Forget the map */
@@ -3102,6 +3280,18 @@ void borg_free_update(void)
 {
     mem_free(borg_wanks);
     borg_wanks = NULL;
+
+    event_remove_handler(EVENT_MAP, borg_feed_map, NULL);
+    event_remove_handler(EVENT_OBJECT_SEEN, borg_feed_map, NULL);
+    event_remove_handler(EVENT_MONSTER_SEEN, borg_feed_monster, NULL);
+    event_remove_handler(EVENT_MONSTER_MOVED, borg_feed_monster, NULL);
+    event_remove_handler(EVENT_NEW_LEVEL_DISPLAY, borg_feed_level, NULL);
+    mem_free(borg_feed.dirty);
+    mem_free(borg_feed.is_dirty);
+    mem_free(borg_feed.seen);
+    mem_free(borg_feed.seen_list);
+    mem_free(borg_feed.seen_pos);
+    memset(&borg_feed, 0, sizeof(borg_feed));
 }
 
 #endif
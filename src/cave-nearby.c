@@ -0,0 +1,229 @@
+/**
+ * \file cave-nearby.c
+ * \brief Find the monsters near a place
+ *
+ * Copyright (c) 2026 The Angband developers
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ *
+ * Each chunk files its monsters in buckets of grids by where they stand.
+ * square_set_mon() keeps the buckets up to date, so anything which puts a
+ * monster on a grid, moves it or takes it away also moves it between
+ * buckets.  Looking for monsters near a place then only visits the buckets
+ * which overlap the area asked about.
+ */
+
+#include "angband.h"
+#include "cave.h"
+#include "init.h"
+
+/**
+ * Get the bucket holding a grid
+ */
+static int bucket_of(const struct mon_buckets *b, struct loc grid)
+{
+	return (grid.y / MON_BUCKET_SIZE) * b->cols + grid.x / MON_BUCKET_SIZE;
+}
+
+/**
+ * File a monster in the bucket holding a grid
+ */
+static void bucket_add(struct mon_buckets *b, int midx, struct loc grid)
+{
+	int n = bucket_of(b, grid);
+
+	b->next[midx] = b->head[n];
+	b->prev[midx] = 0;
+	if (b->head[n]) b->prev[b->head[n]] = midx;
+	b->head[n] = midx;
+	b->grid[midx] = grid;
+}
+
+/**
+ * Take a monster out of the bucket it is filed in
+ */
+static void bucket_remove(struct mon_buckets *b, int midx)
+{
+	int n = bucket_of(b, b->grid[midx]);
+
+	if (b->prev[midx]) {
+		b->next[b->prev[midx]] = b->next[midx];
+	} else {
+		b->head[n] = b->next[midx];
+	}
+	if (b->next[midx]) b->prev[b->next[midx]] = b->prev[midx];
+	b->grid[midx] = loc(-1, -1);
+}
+
+/**
+ * Make empty buckets for a chunk of the given size
+ */
+struct mon_buckets *mon_buckets_new(int height, int width)
+{
+	struct mon_buckets *b = mem_zalloc(sizeof(*b));
+	int i;
+
+	b->rows = (height + MON_BUCKET_SIZE - 1) / MON_BUCKET_SIZE;
+	b->cols = (width + MON_BUCKET_SIZE - 1) / MON_BUCKET_SIZE;
+	b->head = mem_zalloc(b->rows * b->cols * sizeof(*b->head));
+	b->next = mem_zalloc(z_info->level_monster_max * sizeof(*b->next));
+	b->prev = mem_zalloc(z_info->level_monster_max * sizeof(*b->prev));
+	b->grid = mem_alloc(z_info->level_monster_max * sizeof(*b->grid));
+	for (i = 0; i < z_info->level_monster_max; i++) {
+		b->grid[i] = loc(-1, -1);
+	}
+	return b;
+}
+
+/**
+ * Free buckets made by mon_buckets_new()
+ */
+void mon_buckets_free(struct mon_buckets *b)
+{
+	if (!b) return;
+	mem_free(b->head);
+	mem_free(b->next);
+	mem_free(b->prev);
+	mem_free(b->grid);
+	mem_free(b);
+}
+
+/**
+ * Follow a change of the monster on a grid; called by square_set_mon()
+ * before the square changes.
+ * \param c is the chunk
+ * \param grid is the grid
+ * \param midx is the new occupant; only monsters (midx > 0) are filed
+ */
+void mon_buckets_set(struct chunk *c, struct loc grid, int midx)
+{
+	struct mon_buckets *b = c->mon_buckets;
+	int old = c->squares[grid.y][grid.x].mon;
+
+	if (!b) return;
+
+	/* The old occupant may already have been filed somewhere else */
+	if (old > 0 && old != midx && loc_eq(b->grid[old], grid)) {
+		bucket_remove(b, old);
+	}
+
+	if (midx > 0 && !loc_eq(b->grid[midx], grid)) {
+		if (b->grid[midx].x >= 0) bucket_remove(b, midx);
+		bucket_add(b, midx, grid);
+	}
+}
+
+/**
+ * Start a walk over the buckets overlapping a rectangle of grids
+ */
+static void nearby_start(struct nearby_iter *iter, struct chunk *c,
+		struct loc top_left, struct loc bottom_right)
+{
+	struct mon_buckets *b = c->mon_buckets;
+
+	iter->c = c;
+	iter->top_left = loc(MAX(top_left.x, 0), MAX(top_left.y, 0));
+	iter->bottom_right = loc(MIN(bottom_right.x, c->width - 1),
+		MIN(bottom_right.y, c->height - 1));
+	iter->radius = -1;
+	iter->need_los = false;
+	if (iter->top_left.x > iter->bottom_right.x ||
+			iter->top_left.y > iter->bottom_right.y) {
+		/* Nothing to look at */
+		iter->by = b->rows;
+		iter->midx = 0;
+		return;
+	}
+	iter->bx = iter->top_left.x / MON_BUCKET_SIZE;
+	iter->by = iter->top_left.y / MON_BUCKET_SIZE;
+	iter->midx = b->head[iter->by * b->cols + iter->bx];
+}
+
+/**
+ * Start a walk through the monsters in a rectangle of grids.
+ * \param iter is the walk to start
+ * \param c is the chunk
+ * \param top_left is the top left corner of the rectangle
+ * \param bottom_right is the bottom right corner, which is included
+ */
+void nearby_monsters_rect(struct nearby_iter *iter, struct chunk *c,
+		struct loc top_left, struct loc bottom_right)
+{
+	nearby_start(iter, c, top_left, bottom_right);
+}
+
+/**
+ * Start a walk through the monsters no further than radius, as measured by
+ * distance(), from a grid.
+ */
+void nearby_monsters_radius(struct nearby_iter *iter, struct chunk *c,
+		struct loc centre, int radius)
+{
+	nearby_start(iter, c, loc(centre.x - radius, centre.y - radius),
+		loc(centre.x + radius, centre.y + radius));
+	iter->centre = centre;
+	iter->radius = radius;
+}
+
+/**
+ * Start a walk through the monsters no further than radius from a grid and
+ * in line of sight of it.
+ */
+void nearby_monsters_los(struct nearby_iter *iter, struct chunk *c,
+		struct loc centre, int radius)
+{
+	nearby_monsters_radius(iter, c, centre, radius);
+	iter->need_los = true;
+}
+
+/**
+ * Get the next monster of a walk, in no particular order.
+ *
+ * The monster returned may be killed, deleted or moved before asking for the
+ * next, but other monsters must not be; and a monster moved to a bucket not
+ * yet walked may be seen again.
+ * \return the monster, or NULL when there are no more
+ */
+struct monster *nearby_monsters_next(struct nearby_iter *iter)
+{
+	struct mon_buckets *b = iter->c->mon_buckets;
+
+	while (true) {
+		while (iter->midx) {
+			int midx = iter->midx;
+			struct loc grid = b->grid[midx];
+
+			iter->midx = b->next[midx];
+
+			/* Buckets at the edge stick out of the area */
+			if (grid.x < iter->top_left.x || grid.y < iter->top_left.y ||
+				grid.x > iter->bottom_right.x ||
+				grid.y > iter->bottom_right.y) continue;
+			if (iter->radius >= 0 &&
+				distance(iter->centre, grid) > iter->radius) continue;
+			if (iter->need_los && !los(iter->c, iter->centre, grid))
+				continue;
+			return cave_monster(iter->c, midx);
+		}
+
+		/* Move on to the next bucket */
+		if (iter->by >= b->rows) return NULL;
+		if (++iter->bx > iter->bottom_right.x / MON_BUCKET_SIZE) {
+			iter->bx = iter->top_left.x / MON_BUCKET_SIZE;
+			if (++iter->by > iter->bottom_right.y / MON_BUCKET_SIZE) {
+				iter->by = b->rows;
+				return NULL;
+			}
+		}
+		iter->midx = b->head[iter->by * b->cols + iter->bx];
+	}
+}
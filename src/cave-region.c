@@ -0,0 +1,243 @@
+/**
+ * \file cave-region.c
+ * \brief Connected regions of passable grids
+ *
+ * Copyright (c) 2026 The Angband developers
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ *
+ * Grids that can be walked through, and doors, are grouped into regions
+ * with a union-find forest.  Opening up a grid joins it to its neighbours
+ * straight away; closing one can split a region, so that marks the regions
+ * as stale and they are rebuilt from the chunk when next asked about.
+ */
+
+#include "angband.h"
+#include "cave.h"
+#include "generate.h"
+
+/**
+ * Whether grids with a given feature belong to regions
+ */
+static bool feat_isregion(int feat)
+{
+	return feat_is_passable(feat) || tf_has(f_info[feat].flags, TF_DOOR_ANY);
+}
+
+/**
+ * Find the representative of the set holding grid index n, halving the
+ * path along the way
+ */
+static int region_root(struct cave_regions *r, int n)
+{
+	while (r->parent[n] != n) {
+		r->parent[n] = r->parent[r->parent[n]];
+		n = r->parent[n];
+	}
+	return n;
+}
+
+/**
+ * Merge the sets holding grid indices a and b.  The smaller index always
+ * becomes the representative, so each region is named by its first grid.
+ */
+static void region_union(struct cave_regions *r, int a, int b)
+{
+	a = region_root(r, a);
+	b = region_root(r, b);
+	if (a == b) return;
+	if (b < a) {
+		int t = a;
+
+		a = b;
+		b = t;
+	}
+	r->parent[b] = a;
+	r->count[a] += r->count[b];
+	r->num--;
+}
+
+/**
+ * Make grid index n a region of its own
+ */
+static void region_add(struct cave_regions *r, int n)
+{
+	r->parent[n] = n;
+	r->count[n] = 1;
+	r->num++;
+}
+
+/**
+ * Make the regions for a chunk.
+ * \param c is the chunk
+ * \param diagonal is whether grids which only touch at a corner are joined
+ */
+struct cave_regions *cave_regions_new(struct chunk *c, bool diagonal)
+{
+	struct cave_regions *r = mem_zalloc(sizeof(*r));
+	int size = c->height * c->width;
+
+	r->height = c->height;
+	r->width = c->width;
+	r->diagonal = diagonal;
+	r->parent = mem_alloc(size * sizeof(*r->parent));
+	r->count = mem_alloc(size * sizeof(*r->count));
+	cave_regions_rebuild(r, c);
+	return r;
+}
+
+/**
+ * Free regions made by cave_regions_new()
+ */
+void cave_regions_free(struct cave_regions *r)
+{
+	if (!r) return;
+	mem_free(r->parent);
+	mem_free(r->count);
+	mem_free(r);
+}
+
+/**
+ * Work the regions out again from the chunk's terrain, joining each grid to
+ * the neighbours which have already been scanned.
+ */
+void cave_regions_rebuild(struct cave_regions *r, struct chunk *c)
+{
+	int w = r->width;
+	struct loc grid;
+
+	assert(c->height == r->height && c->width == r->width);
+	r->num = 0;
+	for (grid.y = 0; grid.y < r->height; grid.y++) {
+		for (grid.x = 0; grid.x < w; grid.x++) {
+			int n = grid_to_i(grid, w);
+
+			if (!feat_isregion(square(c, grid)->feat)) {
+				r->parent[n] = -1;
+				continue;
+			}
+			region_add(r, n);
+			if (grid.x > 0 && r->parent[n - 1] >= 0) {
+				region_union(r, n, n - 1);
+			}
+			if (grid.y == 0) continue;
+			if (r->parent[n - w] >= 0) {
+				region_union(r, n, n - w);
+			}
+			if (!r->diagonal) continue;
+			if (grid.x > 0 && r->parent[n - w - 1] >= 0) {
+				region_union(r, n, n - w - 1);
+			}
+			if (grid.x < w - 1 && r->parent[n - w + 1] >= 0) {
+				region_union(r, n, n - w + 1);
+			}
+		}
+	}
+	r->stale = false;
+}
+
+/**
+ * Find the region holding a grid.
+ * \return the region's representative, or -1 if the grid is in no region
+ */
+int cave_region_find(struct cave_regions *r, struct loc grid)
+{
+	int n = grid_to_i(grid, r->width);
+
+	if (r->parent[n] < 0) return -1;
+	return region_root(r, n);
+}
+
+/**
+ * Get the number of grids in a region, given its representative
+ */
+int cave_region_size(struct cave_regions *r, int region)
+{
+	return r->count[region];
+}
+
+/**
+ * Add a grid which has been opened up, such as by digging a tunnel, and join
+ * it to the regions next to it.
+ */
+void cave_region_open(struct cave_regions *r, struct loc grid)
+{
+	int n = grid_to_i(grid, r->width);
+	int i;
+
+	if (r->parent[n] >= 0) return;
+	region_add(r, n);
+	for (i = 0; i < (r->diagonal ? 8 : 4); i++) {
+		struct loc adj = loc_sum(grid, ddgrid_ddd[i]);
+
+		if (adj.x < 0 || adj.y < 0 || adj.x >= r->width ||
+				adj.y >= r->height) continue;
+		if (r->parent[grid_to_i(adj, r->width)] >= 0) {
+			region_union(r, n, grid_to_i(adj, r->width));
+		}
+	}
+}
+
+/**
+ * Treat the regions holding two grids as one; does nothing unless both
+ * grids are in a region.
+ */
+void cave_regions_join(struct cave_regions *r, struct loc grid1,
+		struct loc grid2)
+{
+	int n1 = grid_to_i(grid1, r->width);
+	int n2 = grid_to_i(grid2, r->width);
+
+	if (r->parent[n1] < 0 || r->parent[n2] < 0) return;
+	region_union(r, n1, n2);
+}
+
+/**
+ * Keep the chunk's regions, if it has them, up to date with a change of
+ * terrain.
+ * \param c is the chunk
+ * \param grid is the grid which has changed
+ * \param old_feat is the feature the grid had before
+ */
+void cave_regions_changed(struct chunk *c, struct loc grid, int old_feat)
+{
+	bool was_open, is_open;
+
+	if (!c->regions || c->regions->stale) return;
+	was_open = feat_isregion(old_feat);
+	is_open = feat_isregion(square(c, grid)->feat);
+	if (was_open == is_open) return;
+	if (is_open) {
+		cave_region_open(c->regions, grid);
+	} else {
+		c->regions->stale = true;
+	}
+}
+
+/**
+ * Check whether something walking, opening doors as it goes, could get
+ * from one grid to another.  Diagonal steps are allowed.  The regions are
+ * made on the first call for a chunk and kept up to date by
+ * square_set_feat(), so later calls take close to constant time.
+ */
+bool cave_connected(struct chunk *c, struct loc grid1, struct loc grid2)
+{
+	int region;
+
+	if (!c->regions) {
+		c->regions = cave_regions_new(c, true);
+	} else if (c->regions->stale) {
+		cave_regions_rebuild(c->regions, c);
+	}
+	region = cave_region_find(c->regions, grid1);
+	return region >= 0 && region == cave_region_find(c->regions, grid2);
+}
@@ -1184,6 +1184,9 @@ void square_know_pile(struct chunk *c, struct loc grid,
 	}
 
 	forget_remembered_objects(c, player->cave, grid, pred);
+
+	if (square_object(c, grid))
+		event_signal_point(EVENT_OBJECT_SEEN, grid.x, grid.y);
 }
 
 
@@ -1247,6 +1250,7 @@ void square_set_feat(struct chunk *c, struct loc grid, int feat)
 
 	/* Make the change */
 	c->squares[grid.y][grid.x].feat = feat;
+	if (feat != current_feat) cave_regions_changed(c, grid, current_feat);
 
 	/* Light bright terrain */
 	if (feat_is_bright(feat)) {
@@ -1283,6 +1287,7 @@ static void square_set_known_feat(struct chunk *c, struct loc grid, int feat)
  */
 void square_set_mon(struct chunk *c, struct loc grid, int midx)
 {
+	mon_buckets_set(c, grid, midx);
 	c->squares[grid.y][grid.x].mon = midx;
 }
 
@@ -45,6 +45,53 @@ int distance(struct loc grid1, struct loc grid2)
 	return ay > ax ? ay + (ax >> 1) : ax + (ay >> 1);
 }
 
+/**
+ * Find the grids fully inside a chunk that are at exactly the given
+ * distance(), as approximated above, from a point.
+ * \param c is the chunk
+ * \param grid is the point to measure from
+ * \param d is the distance wanted
+ * \param grids must have room for DISTANCE_RING_MAX(d) locations; it is
+ * filled in row-major order (by y, then x)
+ * \return the number of grids found
+ *
+ * For each row offset there are at most three column offsets at a given
+ * distance, so this costs time in proportion to d rather than to the area.
+ */
+int distance_ring(struct chunk *c, struct loc grid, int d, struct loc *grids)
+{
+	int n = 0, dy;
+
+	if (d < 0) return 0;
+	for (dy = -d; dy <= d; dy++) {
+		int ay = ABS(dy);
+		int ax[3], nax = 0, i;
+		struct loc g;
+
+		g.y = grid.y + dy;
+		if (g.y < 1 || g.y >= c->height - 1) continue;
+
+		/* Column offsets at distance d, in increasing order */
+		if (2 * (d - ay) < ay) {
+			ax[nax++] = 2 * (d - ay);
+			if (2 * (d - ay) + 1 < ay) ax[nax++] = 2 * (d - ay) + 1;
+		}
+		if (d - (ay >> 1) >= ay) ax[nax++] = d - (ay >> 1);
+
+		/* West of the point, then east */
+		for (i = nax - 1; i >= 0; i--) {
+			if (!ax[i]) continue;
+			g.x = grid.x - ax[i];
+			if (g.x >= 1 && g.x < c->width - 1) grids[n++] = g;
+		}
+		for (i = 0; i < nax; i++) {
+			g.x = grid.x + ax[i];
+			if (g.x >= 1 && g.x < c->width - 1) grids[n++] = g;
+		}
+	}
+	return n;
+}
+
 
 /**
  * A simple, fast, integer-based line-of-sight algorithm.  By Joseph Hall,
@@ -652,9 +699,11 @@ static void add_light(struct chunk *c, struct player *p, struct loc sgrid,
  */
 static void calc_lighting(struct chunk *c, struct player *p)
 {
-	int dir, k, x, y;
+	int dir, x, y;
 	int light = p->state.cur_light, radius = ABS(light) - 1;
 	int old_light = square_light(c, p->grid);
+	struct nearby_iter iter;
+	struct monster *mon;
 
 	/* Starting values based on permanent light */
 	for (y = 0; y < c->height; y++) {
@@ -693,11 +742,10 @@ static void calc_lighting(struct chunk *c, struct player *p)
 	/* Light around the player */
 	add_light(c, p, p->grid, radius, light);
 
-	/* Scan monster list and add monster light or darkness */
-	for (k = 1; k < cave_monster_max(c); k++) {
-		/* Check the k'th monster */
-		struct monster *mon = cave_monster(c, k);
-
+	/* Add light or darkness from monsters whose light the player can see */
+	nearby_monsters_radius(&iter, c, p->grid,
+		z_info->max_sight + z_info->mon_light_max);
+	while ((mon = nearby_monsters_next(&iter))) {
 		/* Skip dead monsters */
 		if (!mon->race) continue;
 
@@ -370,6 +370,7 @@ struct chunk *cave_new(int height, int width) {
 
 	c->monster_groups = mem_zalloc(z_info->level_monster_max *
 								   sizeof(struct monster_group*));
+	c->mon_buckets = mon_buckets_new(c->height, c->width);
 
 	c->turn = turn;
 	return c;
@@ -423,14 +424,71 @@ void cave_free(struct chunk *c) {
 
 	mem_free(c->feat_count);
 	mem_free(c->objects);
+	mem_free(c->obj_free);
 	mem_free(c->monsters);
 	mem_free(c->monster_groups);
+	cave_regions_free(c->regions);
+	mon_buckets_free(c->mon_buckets);
 	if (c->name)
 		string_free(c->name);
 	mem_free(c);
 }
 
 
+/**
+ * Check whether a slot in the object list for a level/chunk can take a new
+ * object; slots whose known object is still around on the current level can't
+ */
+static bool object_slot_is_free(struct chunk *c, int i)
+{
+	if (i < 1 || i >= c->obj_max || c->objects[i]) return false;
+	if ((c == cave) && player->cave && player->cave->objects[i]) return false;
+	return true;
+}
+
+/**
+ * Note that a slot in the object list for a level/chunk may have become free.
+ *
+ * The slots noted are only candidates, and are checked again when they are
+ * used, so it does no harm to note a slot which turns out not to be free.
+ */
+void release_object_slot(struct chunk *c, int oidx)
+{
+	if (!c || oidx < 1) return;
+	if (c->obj_free_num == c->obj_free_size) {
+		/* Never hold more candidates than there are slots */
+		if (c->obj_free_size > c->obj_max) return;
+		c->obj_free_size += OBJECT_LIST_INCR;
+		c->obj_free = mem_realloc(c->obj_free,
+			c->obj_free_size * sizeof(uint16_t));
+	}
+	c->obj_free[c->obj_free_num++] = oidx;
+}
+
+/**
+ * Find a hole in the object list for a level/chunk, or return 0 if there
+ * isn't one.  If none of the noted slots is free, look through the whole
+ * list once and note every free slot found, lowest first.
+ */
+static int find_object_slot(struct chunk *c)
+{
+	int i;
+
+	while (c->obj_free_num) {
+		i = c->obj_free[--c->obj_free_num];
+		if (object_slot_is_free(c, i)) return i;
+	}
+
+	for (i = c->obj_max - 1; i > 0; i--) {
+		if (object_slot_is_free(c, i)) release_object_slot(c, i);
+	}
+	while (c->obj_free_num) {
+		i = c->obj_free[--c->obj_free_num];
+		if (object_slot_is_free(c, i)) return i;
+	}
+	return 0;
+}
+
 /**
  * Enter an object in the list of objects for the current level/chunk.  This
  * function is robust against listing of duplicates or non-objects
@@ -441,23 +499,16 @@ void list_object(struct chunk *c, struct object *obj)
 
 	/* Check for duplicates and objects already deleted or combined */
 	if (!obj) return;
-	for (i = 1; i < c->obj_max; i++)
-		if (c->objects[i] == obj)
-			return;
+	if (obj->oidx > 0 && obj->oidx < c->obj_max &&
+			c->objects[obj->oidx] == obj)
+		return;
 
 	/* Put objects in holes in the object list */
-	for (i = 1; i < c->obj_max; i++) {
-		/* If there is a known object, skip this slot */
-		if ((c == cave) && player->cave && player->cave->objects[i]) {
-			continue;
-		}
-
-		/* Put the object in a hole */
-		if (c->objects[i] == NULL) {
-			c->objects[i] = obj;
-			obj->oidx = i;
-			return;
-		}
+	i = find_object_slot(c);
+	if (i) {
+		c->objects[i] = obj;
+		obj->oidx = i;
+		return;
 	}
 
 	/* Extend the list */
@@ -469,6 +520,10 @@ void list_object(struct chunk *c, struct object *obj)
 		c->objects[i] = NULL;
 	c->obj_max += OBJECT_LIST_INCR;
 
+	/* The rest of the new slots are free, lowest used first */
+	for (i = c->obj_max - 1; i > obj->oidx; i--)
+		release_object_slot(c, i);
+
 	/* If we're on the current level, extend the known list */
 	if ((c == cave) && player->cave) {
 		player->cave->objects = mem_realloc(player->cave->objects, newsize);
@@ -491,6 +546,7 @@ void delist_object(struct chunk *c, struct object *obj)
 	if ((c == cave) && player->cave->objects[obj->oidx]) return;
 
 	c->objects[obj->oidx] = NULL;
+	release_object_slot(c, obj->oidx);
 	obj->oidx = 0;
 }
 
@@ -171,6 +171,51 @@ struct heatmap {
 	uint16_t **grids;
 };
 
+/**
+ * Connected regions of a chunk, as a union-find forest over its grids.  A
+ * region is named by its representative, the index of its first grid in
+ * row-major order.
+ */
+struct cave_regions {
+	int height;
+	int width;
+	bool diagonal;	/* Whether diagonal neighbours are connected */
+	int *parent;	/* Parent of each grid, or -1 if not in a region */
+	int *count;	/* Number of grids in each region, by representative */
+	int num;	/* Number of regions */
+	bool stale;	/* Whether the regions need rebuilding */
+};
+
+/**
+ * The monsters of a chunk filed by where they stand, in square buckets of
+ * MON_BUCKET_SIZE grids a side, so that the monsters near a place can be
+ * found without looking at every monster on the level.
+ */
+#define MON_BUCKET_SIZE 11
+
+struct mon_buckets {
+	int rows;		/* Number of buckets down the chunk */
+	int cols;		/* Number of buckets across the chunk */
+	int *head;		/* First monster in each bucket, or 0 */
+	int *next;		/* Next monster in the same bucket, or 0 */
+	int *prev;		/* Previous monster in the same bucket, or 0 */
+	struct loc *grid;	/* Where each monster is filed, or (-1, -1) */
+};
+
+/**
+ * A walk through the monsters near a place; see nearby_monsters_next()
+ */
+struct nearby_iter {
+	struct chunk *c;
+	struct loc top_left;	/* Grids looked at */
+	struct loc bottom_right;
+	struct loc centre;
+	int radius;		/* Greatest distance from centre, or -1 for any */
+	bool need_los;		/* Whether to need LOS from centre */
+	int bx, by;		/* Bucket being walked */
+	int midx;		/* Next monster to look at, or 0 */
+};
+
 struct connector {
 	struct loc grid;
 	uint8_t feat;
@@ -201,6 +246,9 @@ struct chunk {
 
 	struct object **objects;
 	uint16_t obj_max;
+	uint16_t *obj_free;	/* Slots which may be free, most recent last */
+	uint16_t obj_free_num;
+	uint16_t obj_free_size;
 
 	struct monster *monsters;
 	uint16_t mon_max;
@@ -211,6 +259,9 @@ struct chunk {
 	struct monster_group **monster_groups;
 
 	struct connector *join;
+
+	struct cave_regions *regions;	/* Made when first needed */
+	struct mon_buckets *mon_buckets;
 };
 
 /*** Feature Indexes (see "lib/gamedata/terrain.txt") ***/
@@ -228,7 +279,9 @@ extern struct chunk **chunk_list;
 extern uint16_t chunk_list_max;
 
 /* cave-view.c */
+#define DISTANCE_RING_MAX(d) (12 * (d) + 6)
 int distance(struct loc grid1, struct loc grid2);
+int distance_ring(struct chunk *c, struct loc grid, int d, struct loc *grids);
 bool los(struct chunk *c, struct loc grid1, struct loc grid2);
 void update_view(struct chunk *c, struct player *p);
 bool no_light(const struct player *p);
@@ -245,6 +298,30 @@ void expose_to_sun(struct chunk *c, struct loc grid, bool daytime);
 void cave_update_flow(struct chunk *c);
 void cave_forget_flow(struct chunk *c);
 
+/* cave-region.c */
+struct cave_regions *cave_regions_new(struct chunk *c, bool diagonal);
+void cave_regions_free(struct cave_regions *r);
+void cave_regions_rebuild(struct cave_regions *r, struct chunk *c);
+int cave_region_find(struct cave_regions *r, struct loc grid);
+int cave_region_size(struct cave_regions *r, int region);
+void cave_region_open(struct cave_regions *r, struct loc grid);
+void cave_regions_join(struct cave_regions *r, struct loc grid1,
+	struct loc grid2);
+void cave_regions_changed(struct chunk *c, struct loc grid, int old_feat);
+bool cave_connected(struct chunk *c, struct loc grid1, struct loc grid2);
+
+/* cave-nearby.c */
+struct mon_buckets *mon_buckets_new(int height, int width);
+void mon_buckets_free(struct mon_buckets *b);
+void mon_buckets_set(struct chunk *c, struct loc grid, int midx);
+void nearby_monsters_rect(struct nearby_iter *iter, struct chunk *c,
+	struct loc top_left, struct loc bottom_right);
+void nearby_monsters_radius(struct nearby_iter *iter, struct chunk *c,
+	struct loc centre, int radius);
+void nearby_monsters_los(struct nearby_iter *iter, struct chunk *c,
+	struct loc centre, int radius);
+struct monster *nearby_monsters_next(struct nearby_iter *iter);
+
 /* cave-square.c */
 /**
  * square_predicate is a function pointer which tests a given square to
@@ -435,6 +512,7 @@ void cave_connectors_free(struct connector *join);
 void cave_free(struct chunk *c);
 void list_object(struct chunk *c, struct object *obj);
 void delist_object(struct chunk *c, struct object *obj);
+void release_object_slot(struct chunk *c, int oidx);
 void object_lists_check_integrity(struct chunk *c, struct chunk *c_k);
 void scatter(struct chunk *c, struct loc *place, struct loc grid, int d,
 			 bool need_los);
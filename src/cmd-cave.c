@@ -1630,6 +1630,7 @@ void do_cmd_hold(struct command *cmd)
 			return;
 		}
 		disturb(player);
+		store_catch_up(store_at(cave, player->grid));
 		event_signal(EVENT_ENTER_STORE);
 		event_remove_handler_type(EVENT_ENTER_STORE);
 		event_signal(EVENT_USE_STORE);
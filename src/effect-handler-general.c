@@ -1766,36 +1766,18 @@ bool effect_handler_DETECT_OBJECTS(effect_handler_context_t *context)
  */
 static bool detect_monsters(int y_dist, int x_dist, monster_predicate pred)
 {
-	int i, x, y;
-	int x1, x2, y1, y2;
-
+	struct nearby_iter iter;
+	struct monster *mon;
 	bool monsters = false;
 
-	/* Set the detection area */
-	y1 = player->grid.y - y_dist;
-	y2 = player->grid.y + y_dist;
-	x1 = player->grid.x - x_dist;
-	x2 = player->grid.x + x_dist;
-
-	if (y1 < 0) y1 = 0;
-	if (x1 < 0) x1 = 0;
-	if (y2 > cave->height - 1) y2 = cave->height - 1;
-	if (x2 > cave->width - 1) x2 = cave->width - 1;
-
-	/* Scan monsters */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		struct monster *mon = cave_monster(cave, i);
-
+	/* Scan monsters in the detection area */
+	nearby_monsters_rect(&iter, cave,
+		loc(player->grid.x - x_dist, player->grid.y - y_dist),
+		loc(player->grid.x + x_dist, player->grid.y + y_dist));
+	while ((mon = nearby_monsters_next(&iter))) {
 		/* Skip dead monsters */
 		if (!mon->race) continue;
 
-		/* Location */
-		y = mon->grid.y;
-		x = mon->grid.x;
-
-		/* Only detect nearby monsters */
-		if (x < x1 || y < y1 || x > x2 || y > y2) continue;
-
 		/* Detect all appropriate, obvious monsters */
 		if (pred(mon) && !monster_is_camouflaged(mon)) {
 			/* Detect the monster */
@@ -2203,16 +2185,17 @@ bool effect_handler_ACQUIRE(effect_handler_context_t *context)
  */
 bool effect_handler_WAKE(effect_handler_context_t *context)
 {
-	int i;
+	struct nearby_iter iter;
+	struct monster *mon;
 	bool woken = false;
+	int radius = z_info->max_sight * 2;
 
 	struct loc origin = origin_get_loc(context->origin);
 
 	/* Wake everyone nearby */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		struct monster *mon = cave_monster(cave, i);
+	nearby_monsters_radius(&iter, cave, origin, radius);
+	while ((mon = nearby_monsters_next(&iter))) {
 		if (mon->race) {
-			int radius = z_info->max_sight * 2;
 			int dist = distance(origin, mon->grid);
 
 			/* Skip monsters too far away */
@@ -2399,7 +2382,8 @@ bool effect_handler_BANISH(effect_handler_context_t *context)
  */
 bool effect_handler_MASS_BANISH(effect_handler_context_t *context)
 {
-	int i;
+	struct nearby_iter iter;
+	struct monster *mon;
 	int radius = context->radius ? context->radius : z_info->max_sight;
 	unsigned dam = 0;
 
@@ -2412,9 +2396,8 @@ bool effect_handler_MASS_BANISH(effect_handler_context_t *context)
 	}
 
 	/* Delete the (nearby) monsters */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		struct monster *mon = cave_monster(cave, i);
-
+	nearby_monsters_radius(&iter, cave, player->grid, radius);
+	while ((mon = nearby_monsters_next(&iter))) {
 		/* Paranoia -- Skip dead monsters */
 		if (!mon->race) continue;
 
@@ -2425,7 +2408,7 @@ bool effect_handler_MASS_BANISH(effect_handler_context_t *context)
 		if (mon->cdis > radius) continue;
 
 		/* Delete the monster */
-		delete_monster_idx(cave, i);
+		delete_monster_idx(cave, mon->midx);
 
 		/* Take some damage */
 		dam += randint1(3);
@@ -2449,14 +2432,13 @@ bool effect_handler_MASS_BANISH(effect_handler_context_t *context)
  */
 bool effect_handler_PROBE(effect_handler_context_t *context)
 {
-	int i;
-
+	struct nearby_iter iter;
+	struct monster *mon;
 	bool probe = false;
 
-	/* Probe all (nearby) monsters */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		struct monster *mon = cave_monster(cave, i);
-
+	/* Probe all (nearby) monsters; the view reaches no further than this */
+	nearby_monsters_radius(&iter, cave, player->grid, z_info->max_sight);
+	while ((mon = nearby_monsters_next(&iter))) {
 		/* Paranoia -- Skip dead monsters */
 		if (!mon->race) continue;
 
@@ -2494,6 +2476,62 @@ bool effect_handler_PROBE(effect_handler_context_t *context)
 	return true;
 }
 
+/**
+ * Find the legal teleport destinations whose distance from the start best
+ * approximates the distance wanted, working outward from that distance one
+ * ring of grids at a time.
+ * \param c is the chunk
+ * \param start is where the teleport starts
+ * \param dis is the distance wanted
+ * \param max_d is the greatest distance from start to any grid in c
+ * \param is_player is whether it is the player that moves
+ * \param vault is whether to look for grids in vaults rather than outside
+ * \param ring is scratch space for 2 * DISTANCE_RING_MAX(max_d) locations
+ * \param spots is filled with the destinations in row-major order; it needs
+ * the same room as ring
+ * \return the number of destinations found
+ */
+static int find_teleport_spots(struct chunk *c, struct loc start, int dis,
+		int max_d, bool is_player, bool vault, struct loc *ring,
+		struct loc *spots)
+{
+	int score;
+
+	for (score = 0; dis - score >= 1 || dis + score <= max_d; score++) {
+		int lo = dis - score, hi = dis + score;
+		int n_lo = 0, n_hi = 0, i, j, num = 0;
+
+		if (lo >= 1 && lo <= max_d) {
+			n_lo = distance_ring(c, start, lo, ring);
+		}
+		if (score && hi >= 1 && hi <= max_d) {
+			n_hi = distance_ring(c, start, hi, ring + n_lo);
+		}
+
+		/* Merge the two rings, keeping the legal grids */
+		i = 0;
+		j = n_lo;
+		while (i < n_lo || j < n_lo + n_hi) {
+			struct loc grid;
+
+			if (j == n_lo + n_hi || (i < n_lo &&
+					(ring[i].y < ring[j].y ||
+					(ring[i].y == ring[j].y &&
+					ring[i].x < ring[j].x)))) {
+				grid = ring[i++];
+			} else {
+				grid = ring[j++];
+			}
+			if (!has_teleport_destination_prereqs(c, grid, is_player))
+				continue;
+			if (square_isvault(c, grid) != vault) continue;
+			spots[num++] = grid;
+		}
+		if (num) return num;
+	}
+	return 0;
+}
+
 /**
  * Teleport player or monster up to context->value.base grids away.
  *
@@ -2508,16 +2546,8 @@ bool effect_handler_TELEPORT(effect_handler_context_t *context)
 	struct loc start = loc(context->x, context->y);
 	int dis = context->value.base;
 	int perc = context->value.m_bonus;
-	int pick;
-	struct loc grid;
-
-	struct jumps {
-		struct loc grid;
-		struct jumps *next;
-	} *spots = NULL;
-	int num_spots = 0;
-	int current_score = 2 * MAX(z_info->dungeon_wid, z_info->dungeon_hgt);
-	bool only_vault_grids_possible = true;
+	int max_d, num_spots;
+	struct loc *ring, *spots, dest;
 
 	bool is_player = (context->origin.what != SRC_MONSTER || context->subtype);
 	struct monster *t_mon = monster_target_monster(context);
@@ -2576,58 +2606,24 @@ bool effect_handler_TELEPORT(effect_handler_context_t *context)
 		dis += randint0(dis / 4);
 	}
 
-	/* Make a list of the best grids, scoring by how good an approximation
-	 * the distance from the start is to the distance we want */
-	for (grid.y = 1; grid.y < cave->height - 1; grid.y++) {
-		for (grid.x = 1; grid.x < cave->width - 1; grid.x++) {
-			int d = distance(grid, start);
-			int score = ABS(d - dis);
-			struct jumps *new;
-
-			/* Must move */
-			if (d == 0) continue;
-
-			if (!has_teleport_destination_prereqs(cave, grid,
-					is_player)) continue;
-
-			/* No teleporting into vaults and such, unless there's no choice */
-			if (square_isvault(cave, grid)) {
-				if (!only_vault_grids_possible) {
-					continue;
-				}
-			} else {
-				/* Just starting to consider non-vault grids, so reset score */
-				if (only_vault_grids_possible) {
-					current_score = 2 * MAX(z_info->dungeon_wid,
-											z_info->dungeon_hgt);
-				}
-				only_vault_grids_possible = false;
-			}
-
-			/* Do we have better spots already? */
-			if (score > current_score) continue;
-
-			/* Make a new spot */
-			new = mem_zalloc(sizeof(struct jumps));
-			new->grid = grid;
-
-			/* If improving start a new list, otherwise extend the old one */
-			if (score < current_score) {
-				current_score = score;
-				while (spots) {
-					struct jumps *next = spots->next;
-					mem_free(spots);
-					spots = next;
-				}
-				spots = new;
-				num_spots = 1;
-			} else {
-				new->next = spots;
-				spots = new;
-				num_spots++;
-			}
-		}
+	/*
+	 * Find the best grids, scoring by how good an approximation the
+	 * distance from the start is to the distance we want.  No teleporting
+	 * into vaults and such, unless there's no choice.
+	 */
+	max_d = MAX(MAX(distance(start, loc(0, 0)),
+		distance(start, loc(cave->width - 1, 0))),
+		MAX(distance(start, loc(0, cave->height - 1)),
+		distance(start, loc(cave->width - 1, cave->height - 1))));
+	ring = mem_alloc(2 * DISTANCE_RING_MAX(max_d) * sizeof(*ring));
+	spots = mem_alloc(2 * DISTANCE_RING_MAX(max_d) * sizeof(*spots));
+	num_spots = find_teleport_spots(cave, start, dis, max_d, is_player,
+		false, ring, spots);
+	if (!num_spots) {
+		num_spots = find_teleport_spots(cave, start, dis, max_d,
+			is_player, true, ring, spots);
 	}
+	mem_free(ring);
 
 	/* Report failure (very unlikely) */
 	if (!num_spots) {
@@ -2646,30 +2642,26 @@ bool effect_handler_TELEPORT(effect_handler_context_t *context)
 					true);
 			}
 		}
+		mem_free(spots);
 		return true;
 	}
 
-	/* Pick a spot */
-	pick = randint0(num_spots);
-	while (pick) {
-		struct jumps *next = spots->next;
-		mem_free(spots);
-		spots = next;
-		pick--;
-	}
+	/* Pick a spot; the latest in row-major order comes first */
+	dest = spots[num_spots - 1 - randint0(num_spots)];
+	mem_free(spots);
 
 	/* Sound */
 	sound(is_player ? MSG_TELEPORT : MSG_TPOTHER);
 
 	/* Move player or monster */
-	monster_swap(start, spots->grid);
+	monster_swap(start, dest);
 	if (is_player) {
 		player_handle_post_move(player, true,
 			context->origin.what == SRC_MONSTER);
 	}
 
 	/* Clear any projection marker to prevent double processing */
-	sqinfo_off(square(cave, spots->grid)->info, SQUARE_PROJECT);
+	sqinfo_off(square(cave, dest)->info, SQUARE_PROJECT);
 
 	/* Clear monster target if it's no longer visible */
 	if (!target_able(target_get_monster())) {
@@ -2679,12 +2671,6 @@ bool effect_handler_TELEPORT(effect_handler_context_t *context)
 	/* Lots of updates after monster_swap */
 	handle_stuff(player);
 
-	while (spots) {
-		struct jumps *next = spots->next;
-		mem_free(spots);
-		spots = next;
-	}
-
 	return true;
 }
 
@@ -17,6 +17,7 @@
  */
 
 #include <assert.h>
+#include <time.h>
 #include "game-event.h"
 #include "object.h"
 #include "z-virt.h"
@@ -30,9 +31,26 @@ struct event_handler_entry
 
 static struct event_handler_entry *event_handlers[N_GAME_EVENTS];
 
-static void game_event_dispatch(game_event_type type, game_event_data *data)
+/**
+ * Counts (and optionally timings) for each type of event
+ */
+static struct event_stats event_stats[N_GAME_EVENTS];
+static bool event_timing;
+
+/**
+ * Events held back by an open batch, and how deeply batches are nested
+ */
+static bool event_pending[N_GAME_EVENTS];
+static int event_batch_depth;
+
+static void game_event_send(game_event_type type, game_event_data *data)
 {
 	struct event_handler_entry *this = event_handlers[type];
+	clock_t start = 0;
+
+	if (!this) return;
+	event_stats[type].dispatched++;
+	if (event_timing) start = clock();
 
 	/* 
 	 * Send the word out to all interested event handlers.
@@ -43,6 +61,80 @@ static void game_event_dispatch(game_event_type type, game_event_data *data)
 		this->fn(type, data, this->user);
 		this = this->next;
 	}
+
+	if (event_timing) event_stats[type].ticks += clock() - start;
+}
+
+static void game_event_dispatch(game_event_type type, game_event_data *data)
+{
+	event_stats[type].signalled++;
+	game_event_send(type, data);
+}
+
+/**
+ * Whether an event only asks for something to be redrawn, so that sending
+ * it once stands in for sending it several times
+ */
+static bool event_coalesces(game_event_type type)
+{
+	switch (type) {
+		case EVENT_INVENTORY:
+		case EVENT_EQUIPMENT:
+		case EVENT_ITEMLIST:
+		case EVENT_MONSTERLIST:
+		case EVENT_REFRESH:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/**
+ * Start holding back redraw events.  Until the matching event_batch_end(),
+ * each redraw event with a handler is sent at most once, when the batch
+ * ends.  Other events are sent as usual.  Batches may be nested; only the
+ * outermost end sends the held events.
+ */
+void event_batch_begin(void)
+{
+	event_batch_depth++;
+}
+
+/**
+ * Finish a batch started by event_batch_begin(), sending any events held
+ * back by it in the order of their types, so EVENT_REFRESH comes after
+ * the redraws it shows.
+ */
+void event_batch_end(void)
+{
+	int type;
+
+	assert(event_batch_depth > 0);
+	if (--event_batch_depth) return;
+
+	for (type = 0; type < N_GAME_EVENTS; type++) {
+		if (!event_pending[type]) continue;
+		event_pending[type] = false;
+		game_event_send(type, NULL);
+	}
+}
+
+/**
+ * Get the counts for one type of event.
+ */
+const struct event_stats *event_get_stats(game_event_type type)
+{
+	return &event_stats[type];
+}
+
+/**
+ * Reset the counts for all types of event and turn the timing of handlers
+ * on or off; timing costs two clock() calls per event sent.
+ */
+void event_reset_stats(bool timing)
+{
+	memset(event_stats, 0, sizeof(event_stats));
+	event_timing = timing;
 }
 
 void event_add_handler(game_event_type type, game_event_handler *fn, void *user)
@@ -139,6 +231,16 @@ void event_remove_handler_set(game_event_type *type, size_t n_types, game_event_
 
 void event_signal(game_event_type type)
 {
+	if (event_batch_depth && event_coalesces(type)) {
+		event_stats[type].signalled++;
+		if (!event_handlers[type]) return;
+		if (event_pending[type]) {
+			event_stats[type].coalesced++;
+		} else {
+			event_pending[type] = true;
+		}
+		return;
+	}
 	game_event_dispatch(type, NULL);
 }
 
@@ -269,6 +371,17 @@ void event_signal_size(game_event_type type, int h, int w)
 	game_event_dispatch(type, &data);
 }
 
+void event_signal_monster(game_event_type type, int midx, struct loc grid,
+	struct loc from)
+{
+	game_event_data data;
+	data.monster.midx = midx;
+	data.monster.grid = grid;
+	data.monster.from = from;
+
+	game_event_dispatch(type, &data);
+}
+
 void event_signal_tunnel(game_event_type type, int nstep, int npierce, int ndug,
 		int dstart, int dend, bool early)
 {
@@ -52,6 +52,9 @@ typedef enum game_event_type
 	EVENT_EXPLOSION,
 	EVENT_BOLT,
 	EVENT_MISSILE,
+	EVENT_MONSTER_SEEN,	/* A monster came into or went out of view */
+	EVENT_MONSTER_MOVED,	/* A monster moved from one grid to another */
+	EVENT_OBJECT_SEEN,	/* The player looked at the objects on a grid */
 
 	EVENT_INVENTORY,
 	EVENT_EQUIPMENT,
@@ -94,11 +97,14 @@ typedef enum game_event_type
 	/* Events for introspection into dungeon generation */
 	EVENT_GEN_LEVEL_START, /* has string in event data for profile name */
 	EVENT_GEN_LEVEL_END, /* has flag in event data indicating success */
+	EVENT_GEN_LEVEL_RESTART, /* has string in event data with the reason */
 	EVENT_GEN_ROOM_START, /* has string in event data for room type */
 	EVENT_GEN_ROOM_CHOOSE_SIZE, /* has size in event data */
 	EVENT_GEN_ROOM_CHOOSE_SUBTYPE, /* has string in event data with name */
 	EVENT_GEN_ROOM_END, /* has flag in event data indicating success */
 	EVENT_GEN_TUNNEL_FINISHED, /* has tunnel in event data with results */
+	EVENT_GEN_STAGE_START, /* has string in event data with stage name */
+	EVENT_GEN_STAGE_END, /* has string in event data with stage name */
 
 	EVENT_END  /* Can be sent at the end of a series of events */
 } game_event_type;
@@ -172,6 +178,13 @@ typedef union
 		int h, w;
 	} size;
 
+	struct
+	{
+		int midx;
+		struct loc grid;
+		struct loc from;
+	} monster;
+
 	struct
 	{
 		/*
@@ -207,12 +220,26 @@ typedef union
  */
 typedef void game_event_handler(game_event_type type, game_event_data *data, void *user);
 
+/**
+ * Running counts for one type of event
+ */
+struct event_stats {
+	uint32_t signalled;	/* Times the event was signalled */
+	uint32_t dispatched;	/* Times it was sent to handlers */
+	uint32_t coalesced;	/* Times it was dropped as a repeat in a batch */
+	clock_t ticks;		/* Time spent in its handlers, if timing */
+};
+
 void event_add_handler(game_event_type type, game_event_handler *fn, void *user);
 void event_remove_handler(game_event_type type, game_event_handler *fn, void *user);
 void event_remove_handler_type(game_event_type type);
 void event_remove_all_handlers(void);
 void event_add_handler_set(game_event_type *type, size_t n_types, game_event_handler *fn, void *user);
 void event_remove_handler_set(game_event_type *type, size_t n_types, game_event_handler *fn, void *user);
+void event_batch_begin(void);
+void event_batch_end(void);
+const struct event_stats *event_get_stats(game_event_type type);
+void event_reset_stats(bool timing);
 
 void event_signal_birthpoints(const int *points, const int *inc_points,
 	int remaining);
@@ -245,6 +272,8 @@ void event_signal_missile(game_event_type type,
 						  int y,
 						  int x);
 void event_signal_size(game_event_type type, int h, int w);
+void event_signal_monster(game_event_type type, int midx, struct loc grid,
+	struct loc from);
 void event_signal_tunnel(game_event_type type, int nstep, int npierce, int ndug,
 	int dstart, int dend, bool early);
 
@@ -1135,6 +1135,10 @@ void run_game_loop(void)
 	/* Now that the player's turn is fully complete, we run the main loop 
 	 * until player input is needed again */
 	while (true) {
+		/* Redraws asked for during this game turn are sent once, at its
+		 * end */
+		event_batch_begin();
+
 		notice_stuff(player);
 		handle_stuff(player);
 		event_signal(EVENT_REFRESH);
@@ -1142,8 +1146,10 @@ void run_game_loop(void)
 		/* Process the rest of the world, give the player energy and 
 		 * increment the turn counter unless we need to stop playing or
 		 * generate a new level */
-		if (player->is_dead || !player->upkeep->playing)
+		if (player->is_dead || !player->upkeep->playing) {
+			event_batch_end();
 			return;
+		}
 		else if (!player->upkeep->generate_level) {
 			/* Process the rest of the monsters */
 			process_monsters(0);
@@ -1155,8 +1161,10 @@ void run_game_loop(void)
 			notice_stuff(player);
 			handle_stuff(player);
 			event_signal(EVENT_REFRESH);
-			if (player->is_dead || !player->upkeep->playing)
+			if (player->is_dead || !player->upkeep->playing) {
+				event_batch_end();
 				return;
+			}
 
 			/* Process the world every ten turns */
 			if (!(turn % 10) && !player->upkeep->generate_level) {
@@ -1166,8 +1174,10 @@ void run_game_loop(void)
 				notice_stuff(player);
 				handle_stuff(player);
 				event_signal(EVENT_REFRESH);
-				if (player->is_dead || !player->upkeep->playing)
+				if (player->is_dead || !player->upkeep->playing) {
+					event_batch_end();
 					return;
+				}
 			}
 
 			/* Give the player some energy */
@@ -1201,6 +1211,8 @@ void run_game_loop(void)
 			}
 		}
 
+		event_batch_end();
+
 		/* If the player has enough energy to move they now do so, after
 		 * any monsters with more energy take their turns */
 		while (player->energy >= z_info->move_energy) {
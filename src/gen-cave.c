@@ -504,6 +504,8 @@ static void build_tunnel(struct chunk *c, struct loc grid1, struct loc grid2)
 	bool door_flag = false;
 	bool preemptive = false;
 
+	event_signal_string(EVENT_GEN_STAGE_START, "tunnel");
+
 	/* Reset the arrays */
 	dun->tunn_n = 0;
 	dun->wall_n = 0;
@@ -760,6 +762,7 @@ static void build_tunnel(struct chunk *c, struct loc grid1, struct loc grid2)
 	event_signal_tunnel(EVENT_GEN_TUNNEL_FINISHED,
 		main_loop_count, dun->wall_n, dun->tunn_n, dstart,
 		ABS(grid1.x - grid2.x) + ABS(grid1.y - grid2.y), preemptive);
+	event_signal_string(EVENT_GEN_STAGE_END, "tunnel");
 }
 
 /**
@@ -1300,9 +1303,11 @@ struct chunk *classic_gen(struct player *p, int min_height, int min_width,
 	i = z_info->level_monster_min + randint1(8) + k;
 
 	/* Put some monsters in the dungeon */
+	event_signal_string(EVENT_GEN_STAGE_START, "allocate");
 	for (; i > 0; i--) {
 		pick_and_place_distant_monster(c, p->grid, 0, true, c->depth);
 	}
+	event_signal_string(EVENT_GEN_STAGE_END, "allocate");
 
 	/* Put some objects in rooms */
 	alloc_objects(c, SET_ROOM, TYP_OBJECT,
@@ -1382,21 +1387,21 @@ static bool lab_is_tunnel(struct chunk *c, struct loc grid) {
  */
 static struct chunk *labyrinth_chunk(int depth, int h, int w, bool lit, bool soft)
 {
-	int i, j, k;
+	int i, j;
 	struct loc grid;
 	int *find_state;
 
 	/* This is the number of squares in the labyrinth */
 	int n = h * w;
 
-	/* NOTE: 'sets' and 'walls' are too large... we only need to use about
-	 * 1/4 as much memory. However, in that case, the addressing math
-	 * becomes a lot more complicated, so let's just stick with this
-	 * because it's easier to read. */
+	/* 'regions' tracks connectedness; cells in the same region are
+	 * connected to each other in the maze. */
+	struct cave_regions *regions;
 
-	/* 'sets' tracks connectedness; if sets[i] == sets[j] then cells i and j
-	 * are connected to each other in the maze. */
-	int *sets;
+	/* NOTE: 'walls' is too large... we only need to use about 1/4 as much
+	 * memory. However, in that case, the addressing math becomes a lot
+	 * more complicated, so let's just stick with this because it's easier
+	 * to read. */
 
 	/* 'walls' is a list of wall coordinates which we will randomize */
 	int *walls;
@@ -1405,7 +1410,6 @@ static struct chunk *labyrinth_chunk(int depth, int h, int w, bool lit, bool sof
 	struct chunk *c = cave_new(h + 2, w + 2);
 	c->depth = depth;
 	/* allocate our arrays */
-	sets = mem_zalloc(n * sizeof(int));
 	walls = mem_zalloc(n * sizeof(int));
 
 	/* Bound with perma-rock */
@@ -1420,20 +1424,20 @@ static struct chunk *labyrinth_chunk(int depth, int h, int w, bool lit, bool sof
 	/* Initialize each wall. */
 	for (i = 0; i < n; i++) {
 		walls[i] = i;
-		sets[i] = -1;
 	}
 
 	/* Cut out a grid of 1x1 rooms which we will call "cells" */
 	for (grid.y = 0; grid.y < h; grid.y += 2) {
 		for (grid.x = 0; grid.x < w; grid.x += 2) {
-			int k_local = grid_to_i(grid, w);
 			struct loc diag = next_grid(grid, DIR_SE);
-			sets[k_local] = k_local;
 			square_set_feat(c, diag, FEAT_FLOOR);
 			if (lit) sqinfo_on(square(c, diag)->info, SQUARE_GLOW);
 		}
 	}
 
+	/* Each cell starts out on its own */
+	regions = cave_regions_new(c, false);
+
 	/* Shuffle the walls, using Knuth's shuffle. */
 	shuffle(walls, n);
 
@@ -1443,6 +1447,7 @@ static struct chunk *labyrinth_chunk(int depth, int h, int w, bool lit, bool sof
 	 * This is a randomized version of Kruskal's algorithm. */
 	for (i = 0; i < n; i++) {
 		int a, b;
+		struct loc grid_a, grid_b;
 
 		j = walls[i];
 
@@ -1454,23 +1459,25 @@ static struct chunk *labyrinth_chunk(int depth, int h, int w, bool lit, bool sof
 
 		/* Figure out which cells are separated by this wall */
 		lab_get_adjoin(j, w, &a, &b);
-
-		/* If the cells aren't connected, kill the wall and join the sets */
-		if (sets[a] != sets[b]) {
-			int sa = sets[a];
-			int sb = sets[b];
+		i_to_grid(a, w, &grid_a);
+		i_to_grid(b, w, &grid_b);
+		grid_a = next_grid(grid_a, DIR_SE);
+		grid_b = next_grid(grid_b, DIR_SE);
+
+		/* If the cells aren't connected, kill the wall, which joins the
+		 * regions */
+		if (cave_region_find(regions, grid_a) !=
+				cave_region_find(regions, grid_b)) {
 			square_set_feat(c, next_grid(grid, DIR_SE), FEAT_FLOOR);
+			cave_region_open(regions, next_grid(grid, DIR_SE));
 			if (lit) {
 				sqinfo_on(square(c, next_grid(grid, DIR_SE))->info, SQUARE_GLOW);
 			}
-			for (k = 0; k < n; k++) {
-				if (sets[k] == sb) sets[k] = sa;
-			}
 		}
 	}
 
 	/* Deallocate our lists */
-	mem_free(sets);
+	cave_regions_free(regions);
 	mem_free(walls);
 
 	/* Generate a door for every 100 squares in the labyrinth */
@@ -1574,9 +1581,11 @@ struct chunk *labyrinth_gen(struct player *p, int min_height, int min_width,
 	alloc_objects(c, SET_CORR, TYP_TRAP, randint1(k), c->depth, 0);
 
 	/* Put some monsters in the dungeon */
+	event_signal_string(EVENT_GEN_STAGE_START, "allocate");
 	for (i = z_info->level_monster_min + randint1(8) + k; i > 0; i--) {
 		pick_and_place_distant_monster(c, p->grid, 0, true, c->depth);
 	}
+	event_signal_string(EVENT_GEN_STAGE_END, "allocate");
 
 	/* Put some objects/gold in the dungeon */
 	alloc_objects(c, SET_BOTH, TYP_OBJECT, Rand_normal(k * 6, 2), c->depth,
@@ -1685,294 +1694,275 @@ static void init_cavern(struct chunk *c, int density,
 }
 
 /**
- * Run a single pass of the cellular automata rules (4,5) on the dungeon.
+ * Add one bit plane to a bit-sliced counter; each bit position of
+ * s[0..3] holds a four bit count for the corresponding grid.
+ */
+static void add_neighbor_plane(uint64_t s[4], uint64_t x)
+{
+	uint64_t carry = s[0] & x;
+
+	s[0] ^= x;
+	x = carry;
+	carry = s[1] & x;
+	s[1] ^= x;
+	x = carry;
+	carry = s[2] & x;
+	s[2] ^= x;
+	s[3] |= carry;
+}
+
+/**
+ * Run passes of the cellular automata rules (4,5) on the dungeon.
  * \param c is the chunk being mutated
+ * \param times is the number of passes
+ *
+ * Passability is packed 64 grids to a word so the neighbors of a whole word
+ * of grids are counted at once with bit-sliced adders.  Each pass rewrites
+ * every interior grid, so only the last pass decides which walls are marked
+ * and the chunk is only written once, at the end.  Stairs and permanent
+ * walls never change.
  */
-static void mutate_cavern(struct chunk *c) {
+static void mutate_cavern(struct chunk *c, int times) {
 	struct loc grid;
 	int h = c->height;
 	int w = c->width;
-
-	int *temp = mem_zalloc(h * w * sizeof(int));
-
-	for (grid.y = 1; grid.y < h - 1; grid.y++) {
-		for (grid.x = 1; grid.x < w - 1; grid.x++) {
-			int count = 8 - count_neighbors(NULL, c, grid,
-				square_ispassable, false);
-			if (square_isstairs(c, grid) ||
-					square_isperm(c, grid)) {
-				temp[grid_to_i(grid, w)] =
-					square(c, grid)->feat;
-			} else if (count > 5) {
-				temp[grid_to_i(grid, w)] = FEAT_GRANITE;
-			} else if (count < 4) {
-				temp[grid_to_i(grid, w)] = FEAT_FLOOR;
-			} else {
-				temp[grid_to_i(grid, w)] =
-					square(c, grid)->feat;
+	int nw = (w + 63) / 64;
+	int size = h * nw;
+	int pass;
+	uint64_t *open = mem_zalloc(size * sizeof(*open));
+	uint64_t *next = mem_zalloc(size * sizeof(*next));
+	uint64_t *fixed = mem_zalloc(size * sizeof(*fixed));
+	uint64_t *walled = mem_zalloc(size * sizeof(*walled));
+	uint64_t *cleared = mem_zalloc(size * sizeof(*cleared));
+	uint64_t *touched = mem_zalloc(size * sizeof(*touched));
+
+	if (times <= 0 || h < 3 || w < 3) {
+		times = 0;
+	}
+
+	/* Pack up the passability and which grids are left alone */
+	for (grid.y = 0; grid.y < h; grid.y++) {
+		for (grid.x = 0; grid.x < w; grid.x++) {
+			int n = grid.y * nw + grid.x / 64;
+			uint64_t bit = (uint64_t) 1 << (grid.x % 64);
+
+			if (square_ispassable(c, grid)) open[n] |= bit;
+			if (square_isstairs(c, grid) || square_isperm(c, grid)) {
+				fixed[n] |= bit;
 			}
 		}
 	}
 
-	for (grid.y = 1; grid.y < h - 1; grid.y++) {
-		for (grid.x = 1; grid.x < w - 1; grid.x++) {
-			if (temp[grid_to_i(grid, w)] == FEAT_GRANITE)
-				set_marked_granite(c, grid, SQUARE_WALL_SOLID);
-			else
-				square_set_feat(c, grid, temp[grid_to_i(grid, w)]);
-		}
-	}
-
-	mem_free(temp);
-}
-
-/**
- * Fill an int[] with a single value.
- * \param data is the array
- * \param value is what it's being filled with
- * \param size is the array length
- */
-static void array_filler(int data[], int value, int size) {
-	int i;
-	for (i = 0; i < size; i++) data[i] = value;
-}
-
-/**
- * Determine if we need to worry about coloring a point, or can ignore it.
- * \param c is the current chunk
- * \param colors is the array of current point colors
- * \param y are the co-ordinates
- * \param x are the co-ordinates
- */
-static int ignore_point(struct chunk *c, int colors[], struct loc grid) {
-	int n = grid_to_i(grid, c->width);
-
-	if (!square_in_bounds(c, grid)) return true;
-	if (colors[n]) return true;
-	if (square_ispassable(c, grid)) return false;
-	if (square_isdoor(c, grid)) return false;
-	return true;
-}
-
-/**
- * Color a particular point, and all adjacent points.
- * \param c is the current chunk
- * \param colors is the array of current point colors
- * \param counts is the array of current color counts
- * \param stairs If not NULL, stairs is an array with the same number of
- * elements as counts.  At exit, stairs[i] will indicate whether the region
- * with color i includes a staircase.
- * \param grid is the location
- * \param color is the color we are coloring
- * \param diagonal controls whether we can progress diagonally
- */
-static void build_color_point(struct chunk *c, int colors[], int counts[],
-		bool *stairs, struct loc grid, int color, bool diagonal) {
-	int h = c->height;
-	int w = c->width;
-	int size = h * w;
-	struct queue *queue = q_new(size);
-
-	int *added = mem_zalloc(size * sizeof(int));
+	for (pass = 0; pass < times; pass++) {
+		int y;
 
-	array_filler(added, 0, size);
+		memcpy(next, open, size * sizeof(*next));
+		for (y = 1; y < h - 1; y++) {
+			const uint64_t *rows[3];
+			int k, r;
 
-	q_push_int(queue, grid_to_i(grid, w));
+			rows[0] = open + (y - 1) * nw;
+			rows[1] = open + y * nw;
+			rows[2] = open + (y + 1) * nw;
+			for (k = 0; k < nw; k++) {
+				uint64_t s[4] = { 0, 0, 0, 0 };
+				uint64_t interior = ~(uint64_t) 0;
+				uint64_t few, many;
+				int n = y * nw + k;
 
-	counts[color] = 0;
+				for (r = 0; r < 3; r++) {
+					uint64_t mid = rows[r][k];
+					uint64_t lo = (k > 0) ? rows[r][k - 1] : 0;
+					uint64_t hi = (k < nw - 1) ? rows[r][k + 1] : 0;
 
-	while (q_len(queue) > 0) {
-		int i;
-		struct loc grid1;
-		int n1 = q_pop_int(queue);
-
-		i_to_grid(n1, w, &grid1);
-
-		if (ignore_point(c, colors, grid1)) continue;
-
-		colors[n1] = color;
-		counts[color]++;
-		if (stairs && square_isstairs(c, grid1)) stairs[color] = true;
+					/* Neighbors to the west and east */
+					add_neighbor_plane(s, (mid << 1) | (lo >> 63));
+					add_neighbor_plane(s, (mid >> 1) | (hi << 63));
+					if (r != 1) add_neighbor_plane(s, mid);
+				}
 
-		for (i = 0; i < (diagonal ? 8 : 4); i++) {
-			struct loc grid2 = loc_sum(grid1, ddgrid_ddd[i]);
-			int n2 = grid_to_i(grid2, w);
-			if (ignore_point(c, colors, grid2)) continue;
-			if (added[n2]) continue;
+				/* Fewer than three open neighbors, or more than four */
+				few = ~s[3] & ~s[2] & ~(s[1] & s[0]);
+				many = s[3] | (s[2] & (s[1] | s[0]));
+
+				/* Only the grids strictly inside the edges change */
+				if (k == 0) interior &= ~(uint64_t) 1;
+				if (k == (w - 1) / 64) {
+					interior &= ((w - 1) % 64) ?
+						((uint64_t) 1 << ((w - 1) % 64)) - 1 : 0;
+				} else if (k > (w - 1) / 64) {
+					interior = 0;
+				}
+				interior &= ~fixed[n];
 
-			q_push_int(queue, n2);
-			added[n2] = 1;
+				walled[n] = few & interior;
+				cleared[n] = many & interior;
+				touched[n] |= walled[n] | cleared[n];
+				next[n] = (next[n] & ~walled[n]) | cleared[n];
+			}
 		}
+		memcpy(open, next, size * sizeof(*open));
 	}
 
-	mem_free(added);
-	q_free(queue);
-}
-
-/**
- * Create a color for each "NESW contiguous" region of the dungeon.
- * \param c is the current chunk
- * \param colors is the array of current point colors
- * \param counts is the array of current color counts
- * \param stairs If not NULL, stairs is an array with the same number of
- * elements as counts.  At exit, stairs[i] will indicate whether the region
- * with color i includes a staircase.
- * \param diagonal controls whether we can progress diagonally
- */
-static void build_colors(struct chunk *c, int colors[], int counts[],
-		bool *stairs, bool diagonal)
-{
-	int y, x;
-	int h = c->height;
-	int w = c->width;
-	int color = 1;
+	/* Write out the result as the last pass would have */
+	for (grid.y = 1; times > 0 && grid.y < h - 1; grid.y++) {
+		for (grid.x = 1; grid.x < w - 1; grid.x++) {
+			int n = grid.y * nw + grid.x / 64;
+			uint64_t bit = (uint64_t) 1 << (grid.x % 64);
+			int feat = square(c, grid)->feat;
 
-	for (y = 0; y < h; y++) {
-		for (x = 0; x < w; x++) {
-			if (ignore_point(c, colors, loc(x, y))) continue;
-			build_color_point(c, colors, counts, stairs,
-				loc(x, y), color, diagonal);
-			color++;
+			if (walled[n] & bit) {
+				set_marked_granite(c, grid, SQUARE_WALL_SOLID);
+				continue;
+			}
+			if (cleared[n] & bit) {
+				feat = FEAT_FLOOR;
+			} else if (touched[n] & bit) {
+				feat = (open[n] & bit) ? FEAT_FLOOR : FEAT_GRANITE;
+			}
+			square_set_feat(c, grid, feat);
 		}
 	}
+
+	mem_free(touched);
+	mem_free(cleared);
+	mem_free(walled);
+	mem_free(fixed);
+	mem_free(next);
+	mem_free(open);
 }
 
 /**
  * Find and delete all small (<9 square) open regions.
  * \param c is the current chunk
- * \param colors is the array of current point colors
- * \param counts is the array of current color counts
- * \param stairs If not NULL, stairs is an array with the same number of
- * elements as counts and stairs[i] will indicate whether the region with
- * color i includes a staircase.  Regions with staircases will not be deleted.
+ * \param r is the chunk's regions, which are rebuilt afterwards
+ * \param keep_stairs If true, regions with staircases will not be deleted.
  */
-static void clear_small_regions(struct chunk *c, int colors[], int counts[],
-		bool *stairs)
+static void clear_small_regions(struct chunk *c, struct cave_regions *r,
+		bool keep_stairs)
 {
-	int i, y, x;
-	int h = c->height;
-	int w = c->width;
-	int size = h * w;
+	int size = c->height * c->width;
+	bool *keep = mem_zalloc(size * sizeof(*keep));
+	struct loc grid;
 
-	int *deleted = mem_zalloc(size * sizeof(int));
-	array_filler(deleted, 0, size);
+	if (keep_stairs) {
+		for (grid.y = 0; grid.y < c->height; grid.y++) {
+			for (grid.x = 0; grid.x < c->width; grid.x++) {
+				int region = cave_region_find(r, grid);
 
-	for (i = 0; i < size; i++) {
-		if (counts[i] < 9 && (!stairs || !stairs[i])) {
-			deleted[i] = 1;
-			counts[i] = 0;
+				if (region >= 0 && square_isstairs(c, grid)) {
+					keep[region] = true;
+				}
+			}
 		}
 	}
 
-	for (y = 1; y < c->height - 1; y++) {
-		for (x = 1; x < c->width - 1; x++) {
-			struct loc grid = loc(x, y);
-			i = grid_to_i(grid, w);
-
-			if (!deleted[colors[i]]) continue;
+	for (grid.y = 1; grid.y < c->height - 1; grid.y++) {
+		for (grid.x = 1; grid.x < c->width - 1; grid.x++) {
+			int region = cave_region_find(r, grid);
 
-			colors[i] = 0;
+			if (region < 0 || keep[region] ||
+					cave_region_size(r, region) >= 9) continue;
 			set_marked_granite(c, grid, SQUARE_WALL_SOLID);
 		}
 	}
-	mem_free(deleted);
+	mem_free(keep);
+	cave_regions_rebuild(r, c);
 }
 
 /**
- * Return the number of colors which have active cells.
- * \param counts is the array of current color counts
- * \param size is the total area
+ * Return the first region, in row-major order, or -1 if there are none.
+ * \param c is the current chunk
+ * \param r is the chunk's regions
  */
-static int count_colors(int counts[], int size) {
-	int i;
-	int num = 0;
-	for (i = 0; i < size; i++) if (counts[i] > 0) num++;
-	return num;
-}
+static int first_region(struct chunk *c, struct cave_regions *r)
+{
+	struct loc grid;
 
-/**
- * Return the first color which has one or more active cells.
- * \param counts is the array of current color counts
- * \param size is the total area
- */
-static int first_color(int counts[], int size) {
-	int i;
-	for (i = 0; i < size; i++) if (counts[i] > 0) return i;
-	return -1;
-}
+	for (grid.y = 0; grid.y < c->height; grid.y++) {
+		for (grid.x = 0; grid.x < c->width; grid.x++) {
+			int region = cave_region_find(r, grid);
 
-/**
- * Find all cells of 'fromcolor' and repaint them to 'tocolor'.
- * \param colors is the array of current point colors
- * \param counts is the array of current color counts
- * \param from is the color to change
- * \param to is the color to change to
- * \param size is the total area
- */
-static void fix_colors(int colors[], int counts[], int from, int to, int size) {
-	int i;
-	for (i = 0; i < size; i++) if (colors[i] == from) colors[i] = to;
-	counts[to] += counts[from];
-	counts[from] = 0;
+			if (region >= 0) return region;
+		}
+	}
+	return -1;
 }
 
 /**
  * Create a tunnel connecting a region to one of its nearest neighbors.
- * Set new_color = -1 for any neighbour, the required color for a specific one
+ * Set new_region = -1 for any neighbour, the required region for a specific
+ * one
  * \param c is the current chunk
- * \param colors is the array of current point colors
- * \param counts is the array of current color counts
- * \param color is the color of the region we want to connect
- * \param new_color is the color of the region we want to connect to (if used)
+ * \param r is the chunk's regions, which are joined as the tunnel is dug
+ * \param region is the region we want to connect
+ * \param new_region is the region we want to connect to (if used)
  * \param allow_vault_disconnect If true, vaults can be included in path
  * planning which can leave regions disconnected.
+ * \return whether another region was found to connect to
  */
-static void join_region(struct chunk *c, int colors[], int counts[], int color,
-	int new_color, bool allow_vault_disconnect)
+static bool join_region(struct chunk *c, struct cave_regions *r, int region,
+	int new_region, bool allow_vault_disconnect)
 {
 	int i;
 	int h = c->height;
 	int w = c->width;
 	int size = h * w;
+	bool joined = false;
 
 	/* Allocate a processing queue */
-	struct queue *queue = q_new(size);
+	struct queue *queue;
 
 	/* Allocate an array to keep track of handled squares, and which square
 	 * we reached them from.
 	 */
-	int *previous = mem_zalloc(size * sizeof(int));
-	array_filler(previous, -1, size);
+	int *previous;
+
+	if (region < 0) return false;
+	queue = q_new(size);
+	previous = mem_alloc(size * sizeof(int));
 
-	/* Push all squares of the given color onto the queue */
+	/* Push all squares of the given region onto the queue */
 	for (i = 0; i < size; i++) {
-		if (colors[i] == color) {
+		struct loc grid;
+
+		i_to_grid(i, w, &grid);
+		if (cave_region_find(r, grid) == region) {
 			q_push_int(queue, i);
 			previous[i] = i;
+		} else {
+			previous[i] = -1;
 		}
 	}
 
 	/* Process all squares into the queue */
 	while (q_len(queue) > 0) {
-		/* Get the current square and its color */
+		/* Get the current square and its region */
 		int n1 = q_pop_int(queue);
-		int color2 = colors[n1];
+		struct loc grid1;
+		int region2;
 
-		/* If we're not looking for a specific color, any new one will do */
-		if ((new_color == -1) && color2 && (color2 != color))
-			new_color = color2;
+		i_to_grid(n1, w, &grid1);
+		region2 = cave_region_find(r, grid1);
 
-		/* See if we've reached a square with a new color */
-		if (color2 == new_color) {
-			/* Step backward through the path, turning stone to tunnel */
-			while (colors[n1] != color) {
+		/* If we're not looking for a specific region, any new one will do */
+		if ((new_region == -1) && (region2 >= 0) && (region2 != region))
+			new_region = region2;
+
+		/* See if we've reached a square in a new region */
+		if (region2 >= 0 && region2 == new_region) {
+			struct loc start;
+
+			/* Find where the path starts */
+			for (i = n1; previous[i] != i; i = previous[i]);
+			i_to_grid(i, w, &start);
+
+			/* Step backward through the path, turning stone to
+			 * tunnel.  The whole path counts as part of the region,
+			 * even where a vault is in the way. */
+			while (previous[n1] != n1) {
 				struct loc grid;
 				i_to_grid(n1, w, &grid);
-				if (colors[n1] > 0) {
-					--counts[colors[n1]];
-				}
-				++counts[color];
-				colors[n1] = color;
 				/* Don't break permanent walls or vaults.  Also
 				 * don't override terrain that already allows
 				 * passage. */
@@ -1981,27 +1971,25 @@ static void join_region(struct chunk *c, int colors[], int counts[], int color,
 						!(square_ispassable(c, grid) ||
 						square_isdoor(c, grid))) {
 					square_set_feat(c, grid, FEAT_FLOOR);
+					cave_region_open(r, grid);
 				}
+				cave_regions_join(r, grid, start);
 				n1 = previous[n1];
 			}
 
-			/* Update the color mapping to combine the two colors */
-			fix_colors(colors, counts, color2, color, size);
-
 			/* We're done now */
+			joined = true;
 			break;
 		}
 
-		/* If we haven't reached a new color, add all the unprocessed adjacent
-		 * squares to our queue.
+		/* If we haven't reached a new region, add all the unprocessed
+		 * adjacent squares to our queue.
 		 */
 		for (i = 0; i < 4; i++) {
 			int n2;
-			struct loc grid;
-			i_to_grid(n1, w, &grid);
 
 			/* Move to the adjacent square */
-			grid = loc_sum(grid, ddgrid_ddd[i]);
+			struct loc grid = loc_sum(grid1, ddgrid_ddd[i]);
 
 			/* Make sure we stay inside the boundaries */
 			if (!square_in_bounds(c, grid)) continue;
@@ -2021,32 +2009,26 @@ static void join_region(struct chunk *c, int colors[], int counts[], int color,
 	/* Free the memory we've allocated */
 	q_free(queue);
 	mem_free(previous);
+
+	return joined;
 }
 
 
 /**
  * Start connecting regions, stopping when the cave is entirely connected.
  * \param c is the current chunk
- * \param colors is the array of current point colors
- * \param counts is the array of current color counts
+ * \param r is the chunk's regions
  * \param allow_vault_disconnect If true, allows vaults to be included in
  * path planning which can leave regions disconnected.
  */
-static void join_regions(struct chunk *c, int colors[], int counts[],
+static void join_regions(struct chunk *c, struct cave_regions *r,
 		bool allow_vault_disconnect) {
-	int h = c->height;
-	int w = c->width;
-	int size = h * w;
-	int num = count_colors(counts, size);
-
-	/* While we have multiple colors (i.e. disconnected regions), join one
-	 * of the regions to another one.
+	/* While we have multiple disconnected regions, join the first one to
+	 * its nearest neighbour.
 	 */
-	while (num > 1) {
-		int color = first_color(counts, size);
-		join_region(c, colors, counts, color, -1,
-			allow_vault_disconnect);
-		num--;
+	while (r->num > 1) {
+		if (!join_region(c, r, first_region(c, r), -1,
+				allow_vault_disconnect)) break;
 	}
 }
 
@@ -2055,19 +2037,17 @@ static void join_regions(struct chunk *c, int colors[], int counts[],
  * Make sure that all the regions of the dungeon are connected.
  * \param c is the current chunk
  *
- * This function colors each connected region of the dungeon, then uses that
- * information to join them into one conected region.
+ * This function finds each connected region of the dungeon, then joins them
+ * into one connected region.
  */
 void ensure_connectedness(struct chunk *c, bool allow_vault_disconnect) {
-	int size = c->height * c->width;
-	int *colors = mem_zalloc(size * sizeof(int));
-	int *counts = mem_zalloc(size * sizeof(int));
+	struct cave_regions *r;
 
-	build_colors(c, colors, counts, NULL, true);
-	join_regions(c, colors, counts, allow_vault_disconnect);
-
-	mem_free(colors);
-	mem_free(counts);
+	event_signal_string(EVENT_GEN_STAGE_START, "connect");
+	r = cave_regions_new(c, true);
+	join_regions(c, r, allow_vault_disconnect);
+	cave_regions_free(r);
+	event_signal_string(EVENT_GEN_STAGE_END, "connect");
 }
 
 
@@ -2091,9 +2071,7 @@ static struct chunk *cavern_chunk(int depth, int h, int w,
 	int density = rand_range(25, 40);
 	int times = rand_range(3, 6);
 
-	int *colors = mem_zalloc(size * sizeof(int));
-	int *counts = mem_zalloc(size * sizeof(int));
-	bool *stairs = (join) ? mem_zalloc(size * sizeof(*stairs)) : NULL;
+	struct cave_regions *r;
 	int tries;
 
 	struct chunk *c = cave_new(h, w);
@@ -2106,7 +2084,7 @@ static struct chunk *cavern_chunk(int depth, int h, int w,
 	for (tries = 0; tries < MAX_CAVERN_TRIES; tries++) {
 		/* Build a random cavern and mutate it a number of times */
 		init_cavern(c, density, join);
-		for (i = 0; i < times; i++) mutate_cavern(c);
+		mutate_cavern(c, times);
 
 		/* If there are enough open squares then we're done */
 		if (c->feat_count[FEAT_FLOOR] >= limit) {
@@ -2119,16 +2097,16 @@ static struct chunk *cavern_chunk(int depth, int h, int w,
 
 	/* If we couldn't make a big enough cavern then fail */
 	if (tries == MAX_CAVERN_TRIES) {
-		mem_free(colors);
-		mem_free(counts);
-		mem_free(stairs);
 		cave_free(c);
 		return NULL;
 	}
 
-	build_colors(c, colors, counts, stairs, false);
-	clear_small_regions(c, colors, counts, stairs);
-	join_regions(c, colors, counts, true);
+	event_signal_string(EVENT_GEN_STAGE_START, "connect");
+	r = cave_regions_new(c, false);
+	clear_small_regions(c, r, join != NULL);
+	join_regions(c, r, true);
+	cave_regions_free(r);
+	event_signal_string(EVENT_GEN_STAGE_END, "connect");
 
 	/* Convert the permanent rock walls near stairs back to granite. */
 	while (join) {
@@ -2142,10 +2120,6 @@ static struct chunk *cavern_chunk(int depth, int h, int w,
 		join = join->next;
 	}
 
-	mem_free(colors);
-	mem_free(counts);
-	mem_free(stairs);
-
 	return c;
 }
 
@@ -2207,9 +2181,11 @@ struct chunk *cavern_gen(struct player *p, int min_height, int min_width,
 	}
 
 	/* Put some monsters in the dungeon */
+	event_signal_string(EVENT_GEN_STAGE_START, "allocate");
 	for (i = randint1(8) + k; i > 0; i--) {
 		pick_and_place_distant_monster(c, p->grid, 0, true, c->depth);
 	}
+	event_signal_string(EVENT_GEN_STAGE_END, "allocate");
 
 	/* Put some objects/gold in the dungeon */
 	alloc_objects(c, SET_BOTH, TYP_OBJECT, Rand_normal(k, 2), c->depth + 5,
@@ -2700,10 +2676,12 @@ struct chunk *town_gen(struct player *p, int min_height, int min_width,
 	cave_illuminate(c_new, is_daytime());
 
 	/* Make some residents */
+	event_signal_string(EVENT_GEN_STAGE_START, "allocate");
 	for (i = 0; i < residents; i++) {
 		pick_and_place_distant_monster(c_new, p->grid, 3, true,
 			c_new->depth);
 	}
+	event_signal_string(EVENT_GEN_STAGE_END, "allocate");
 
 	return c_new;
 }
@@ -2937,9 +2915,11 @@ struct chunk *modified_gen(struct player *p, int min_height, int min_width,
 	mon_restrict(NULL, c->depth, c->depth, true);
 
 	/* Put some monsters in the dungeon */
+	event_signal_string(EVENT_GEN_STAGE_START, "allocate");
 	for (; i > 0; i--) {
 		pick_and_place_distant_monster(c, p->grid, 0, true, c->depth);
 	}
+	event_signal_string(EVENT_GEN_STAGE_END, "allocate");
 
 	/* Put some objects in rooms */
 	alloc_objects(c, SET_ROOM, TYP_OBJECT,
@@ -3175,9 +3155,11 @@ struct chunk *moria_gen(struct player *p, int min_height, int min_width,
 	mon_restrict("Moria dwellers", c->depth, c->depth, true);
 
 	/* Put some monsters in the dungeon */
+	event_signal_string(EVENT_GEN_STAGE_START, "allocate");
 	for (; i > 0; i--) {
 		pick_and_place_distant_monster(c, p->grid, 0, true, c->depth);
 	}
+	event_signal_string(EVENT_GEN_STAGE_END, "allocate");
 
 	/* Remove our restrictions. */
 	(void) mon_restrict(NULL, c->depth, c->depth, false);
@@ -3241,35 +3223,19 @@ static struct chunk *vault_chunk(struct player *p)
  */
 static void connect_caverns(struct chunk *c, struct loc floor[])
 {
-	int i;
-	int size = c->height * c->width;
-	int *colors = mem_zalloc(size * sizeof(int));
-	int *counts = mem_zalloc(size * sizeof(int));
-	int color_of_floor[4];
-
-	/* Color the regions, find which cavern is which color */
-	build_colors(c, colors, counts, NULL, true);
-	for (i = 0; i < 4; i++) {
-		int spot = grid_to_i(floor[i], c->width);
-		color_of_floor[i] = colors[spot];
-	}
+	struct cave_regions *r = cave_regions_new(c, true);
 
 	/* Join left and upper, right and lower */
-	join_region(c, colors, counts, color_of_floor[0], color_of_floor[1],
-		false);
-	join_region(c, colors, counts, color_of_floor[2], color_of_floor[3],
-		false);
+	join_region(c, r, cave_region_find(r, floor[0]),
+		cave_region_find(r, floor[1]), false);
+	join_region(c, r, cave_region_find(r, floor[2]),
+		cave_region_find(r, floor[3]), false);
 
 	/* Join the two big caverns */
-	for (i = 1; i < 3; i++) {
-		int spot = grid_to_i(floor[i], c->width);
-		color_of_floor[i] = colors[spot];
-	}
-	join_region(c, colors, counts, color_of_floor[1], color_of_floor[2],
-		false);
+	join_region(c, r, cave_region_find(r, floor[1]),
+		cave_region_find(r, floor[2]), false);
 
-	mem_free(colors);
-	mem_free(counts);
+	cave_regions_free(r);
 }
 /**
  * Generate a hard centre level - a greater vault surrounded by caverns
@@ -3496,9 +3462,11 @@ struct chunk *hard_centre_gen(struct player *p, int min_height, int min_width,
 	}
 
 	/* Put some monsters in the dungeon */
+	event_signal_string(EVENT_GEN_STAGE_START, "allocate");
 	for (i = randint1(8) + k; i > 0; i--) {
 		pick_and_place_distant_monster(c, p->grid, 0, true, c->depth);
 	}
+	event_signal_string(EVENT_GEN_STAGE_END, "allocate");
 
 	/* Put some objects/gold in the dungeon */
 	alloc_objects(c, SET_BOTH, TYP_OBJECT, Rand_normal(k, 2), c->depth + 5,
@@ -3632,10 +3600,12 @@ struct chunk *lair_gen(struct player *p, int min_height, int min_width,
 	i = randint1(4) + k;
 
 	/* Put some monsters in the dungeon */
+	event_signal_string(EVENT_GEN_STAGE_START, "allocate");
 	for (; i > 0; i--) {
 		pick_and_place_distant_monster(normal, p->grid, 0, true,
 			normal->depth);
 	}
+	event_signal_string(EVENT_GEN_STAGE_END, "allocate");
 
 	/* Add some magma streamers */
 	for (i = 0; i < dun->profile->str.mag; i++)
@@ -3878,19 +3848,23 @@ struct chunk *gauntlet_gen(struct player *p, int min_height, int min_width,
 	i = z_info->level_monster_min + randint1(4) + k;
 
 	/* Place the monsters */
+	event_signal_string(EVENT_GEN_STAGE_START, "allocate");
 	for (; i > 0; i--) {
 		pick_and_place_distant_monster(left, p_loc_in_l, 0, true,
 			left->depth);
 	}
+	event_signal_string(EVENT_GEN_STAGE_END, "allocate");
 
 	/* Pick some of monsters for the right cavern */
 	i = z_info->level_monster_min + randint1(4) + k;
 
 	/* Place the monsters */
+	event_signal_string(EVENT_GEN_STAGE_START, "allocate");
 	for (; i > 0; i--) {
 		pick_and_place_distant_monster(right, p_loc_in_r, 0, true,
 			right->depth);
 	}
+	event_signal_string(EVENT_GEN_STAGE_END, "allocate");
 
 	/* Pick a larger number of monsters for the gauntlet */
 	i = (z_info->level_monster_min + randint1(6) + k);
@@ -426,7 +426,7 @@ bool chunk_copy(struct chunk *dest, struct player *p, struct chunk *source,
 
 		/* Move grid */
 		symmetry_transform(&dest_mon->grid, y0, x0, h, w, rotate, reflect);
-		dest->squares[dest_mon->grid.y][dest_mon->grid.x].mon = dest_mon->midx;
+		square_set_mon(dest, dest_mon->grid, dest_mon->midx);
 
 		/* Held or mimicked objects */
 		if (source_mon->held_obj) {
@@ -267,20 +267,19 @@ void spread_monsters(struct chunk *c, const char *type, int depth, int num,
  *
  * \param c the current chunk being generated
  * \param racial_symbol the allowable monster_base symbols
- * \param vault_type the type of vault, which affects monster selection depth
- * \param data the vault text description, which contains the racial symbol
- * \param y1 the limits of the vault
- * \param y2 the limits of the vault
- * \param x1 the limits of the vault
- * \param x2 the limits of the vault
+ * \param v the vault; its type affects monster selection depth, and its
+ * layout holds the racial symbols
+ * \param corner the top left corner of the vault as built
+ * \param rotate the rotation the vault was built with
+ * \param reflect whether the vault was built reflected
  */
-void get_vault_monsters(struct chunk *c, char racial_symbol[], char *vault_type,
-						const char *data, int y1, int y2, int x1, int x2)
+void get_vault_monsters(struct chunk *c, char racial_symbol[],
+		const struct vault *v, struct loc corner, int rotate,
+		bool reflect)
 {
-	int i, y, x, depth;
+	int i, j, depth;
 	char stmp[2] = { '\0', '\0' };
 	wchar_t wtmp[2];
-	const char *t;
 
 	for (i = 0; racial_symbol[i] != '\0'; i++) {
 		/* Require correct race, allow uniques. */
@@ -297,11 +296,11 @@ void get_vault_monsters(struct chunk *c, char racial_symbol[], char *vault_type,
 		select_current_level = c->depth;
 
 		/* Determine level of monster */
-		if (strstr(vault_type, "Lesser vault"))
+		if (strstr(v->typ, "Lesser vault"))
 			depth = c->depth + 2;
-		else if (strstr(vault_type, "Medium vault"))
+		else if (strstr(v->typ, "Medium vault"))
 			depth = c->depth + 4;
-		else if (strstr(vault_type, "Greater vault"))
+		else if (strstr(v->typ, "Greater vault"))
 			depth = c->depth + 6;
 		else
 			depth = c->depth;
@@ -315,14 +314,18 @@ void get_vault_monsters(struct chunk *c, char racial_symbol[], char *vault_type,
 
 
 		/* Place the monsters */
-		for (t = data, y = y1; y <= y2; y++) {
-			for (x = x1; x <= x2; x++, t++) {
-				if (*t == racial_symbol[i]) {
-					/* Place a monster */
-					pick_and_place_monster(c, loc(x, y), depth, false,
-																false, ORIGIN_DROP_SPECIAL);
-				}
-			}
+		for (j = 0; j < v->n_late_cells; j++) {
+			const struct room_cell *cell = &v->late_cells[j];
+			struct loc grid;
+
+			if (cell->glyph != racial_symbol[i]) continue;
+
+			/* Place a monster where the vault put the symbol */
+			grid = loc(cell->x, cell->y);
+			symmetry_transform(&grid, corner.y, corner.x, v->hgt,
+				v->wid, rotate, reflect);
+			pick_and_place_monster(c, grid, depth, false, false,
+				ORIGIN_DROP_SPECIAL);
 		}
 	}
 
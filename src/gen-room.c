@@ -54,17 +54,16 @@
  */
 static struct room_template *random_room_template(int typ, int rating)
 {
-	struct room_template *t = room_templates;
-	struct room_template *r = NULL;
-	int n = 1;
-	do {
-		if ((t->typ == typ) && (t->rat == rating)) {
-			if (one_in_(n)) r = t;
-			n++;
-		}
-		t = t->next;
-	} while(t);
-	return r;
+	int i;
+
+	for (i = 0; i < n_room_template_picks; i++) {
+		struct room_template_pick *pick = &room_template_picks[i];
+
+		if (pick->typ == typ && pick->rat == rating) {
+			return pick->rooms[randint0(pick->n_rooms)];
+		}
+	}
+	return NULL;
 }
 
 /**
@@ -75,18 +74,29 @@ static struct room_template *random_room_template(int typ, int rating)
  */
 struct vault *random_vault(int depth, const char *typ)
 {
-	struct vault *v = vaults;
-	struct vault *r = NULL;
-	int n = 1;
-	do {
-		if (streq(v->typ, typ) && (v->min_lev <= depth)
-			&& (v->max_lev >= depth)) {
-			if (one_in_(n)) r = v;
-			n++;
-		}
-		v = v->next;
-	} while(v);
-	return r;
+	struct vault_pick *pick = NULL;
+	int i, n = 0;
+
+	for (i = 0; i < n_vault_picks; i++) {
+		if (streq(vault_picks[i].typ, typ)) {
+			pick = &vault_picks[i];
+			break;
+		}
+	}
+	if (!pick) return NULL;
+
+	/* Count the vaults allowed at this depth, then take one of them */
+	for (i = 0; i < pick->n_vaults; i++) {
+		if (pick->vaults[i]->min_lev <= depth &&
+				pick->vaults[i]->max_lev >= depth) n++;
+	}
+	if (!n) return NULL;
+	n = randint0(n);
+	for (i = 0; i < pick->n_vaults; i++) {
+		if (pick->vaults[i]->min_lev <= depth &&
+				pick->vaults[i]->max_lev >= depth && n-- == 0) break;
+	}
+	return pick->vaults[i];
 }
 
 
@@ -1099,23 +1109,19 @@ static bool find_space(struct loc *centre, int height, int width)
 }
 
 /**
- * Build a room template from its string representation.
+ * Build a room template from its compiled layout.
  * \param c the chunk the room is being built in
  * \param centre the room centre; out of chunk centre invokes find_space()
- * \param ymax the room dimensions
- * \param xmax the room dimensions
- * \param doors the door position
- * \param data the room template text description
- * \param tval the object type for any included objects
- * \param flags the flags for the room
+ * \param room the room template
  * \return success
  */
-static bool build_room_template(struct chunk *c, struct loc centre, int ymax,
-	int xmax, int doors, const char *data, int tval,
-	const bitflag flags[ROOMF_SIZE])
+static bool build_room_template(struct chunk *c, struct loc centre,
+	const struct room_template *room)
 {
-	int dx, dy, rnddoors, doorpos;
-	const char *t;
+	int ymax = room->hgt, xmax = room->wid;
+	int tval = room->tval;
+	const bitflag *flags = room->flags;
+	int i, rnddoors, doorpos;
 	bool rndwalls, light;
 	int rotate, txmax, tymax;
 	bool reflect;
@@ -1127,7 +1133,7 @@ static bool build_room_template(struct chunk *c, struct loc centre, int ymax,
 
 	/* Set the random door position here so it generates doors in all squares
 	 * marked with the same number */
-	rnddoors = randint1(doors);
+	rnddoors = randint1(room->dor);
 
 	/* Decide whether optional walls will be generated this time */
 	rndwalls = one_in_(2) ? true : false;
@@ -1155,179 +1161,174 @@ static bool build_room_template(struct chunk *c, struct loc centre, int ymax,
 	centre.y -= tymax / 2;
 
 	/* Place dungeon features, objects, and monsters for specific grids. */
-	for (t = data, dy = 0; dy < ymax && *t; dy++) {
-		for (dx = 0; dx < xmax && *t; dx++, t++) {
-			/* Extract the location */
-			struct loc grid = loc(dx, dy);
-
-			symmetry_transform(&grid, centre.y, centre.x,
-				ymax, xmax, rotate, reflect);
-
-			/* Skip non-grids */
-			if (*t == ' ') continue;
-
-			/* Lay down a floor */
-			square_set_feat(c, grid, FEAT_FLOOR);
-
-			/* Debugging assertion */
-			assert(square_isempty(c, grid));
-
-			/* Analyze the grid */
-			switch (*t) {
-			case '%': {
-				set_marked_granite(c, grid, SQUARE_WALL_OUTER);
-				if (roomf_has(flags, ROOMF_FEW_ENTRANCES)) {
-					append_entrance(grid);
-				}
-				break;
-			}
-			case '#': set_marked_granite(c, grid, SQUARE_WALL_SOLID); break;
-			case '+': place_closed_door(c, grid); break;
-			case '^': if (one_in_(4)) place_trap(c, grid, -1, c->depth); break;
-			case 'x': {
-
-				/* If optional walls are generated, put a wall in this square */
-				if (rndwalls)
-					set_marked_granite(c, grid, SQUARE_WALL_SOLID);
-				break;
-			}
-			case '(': {
-
-				/* If optional walls are generated, put a door in this square */
-				if (rndwalls)
-					place_secret_door(c, grid);
-				break;
+	for (i = 0; i < room->n_cells; i++) {
+		const struct room_cell *cell = &room->cells[i];
+		/* Extract the location */
+		struct loc grid = loc(cell->x, cell->y);
+
+		symmetry_transform(&grid, centre.y, centre.x,
+			ymax, xmax, rotate, reflect);
+
+		/* Lay down a floor */
+		square_set_feat(c, grid, FEAT_FLOOR);
+
+		/* Debugging assertion */
+		assert(square_isempty(c, grid));
+
+		/* Analyze the grid */
+		switch (cell->glyph) {
+		case '%': {
+			set_marked_granite(c, grid, SQUARE_WALL_OUTER);
+			if (roomf_has(flags, ROOMF_FEW_ENTRANCES)) {
+				append_entrance(grid);
 			}
-			case ')': {
-				/* If no optional walls generated, put a door in this square */
-				if (!rndwalls)
-					place_secret_door(c, grid);
-				else
-					set_marked_granite(c, grid, SQUARE_WALL_SOLID);
-				break;
-			}
-			case '8': {
-				/* Put something nice in this square
-				 * Object (80%) or Stairs (20%) */
-				if (randint0(100) < 80 || dun->persist) {
-					place_object(c, grid, c->depth, false, false,
-								 ORIGIN_SPECIAL, 0);
-				} else {
-					place_random_stairs(c, grid, dun->quest);
-				}
-				/* Place nearby guards in second pass. */
-				break;
-			}
-			case '9': {
-				/* Everything is handled in the second pass. */
-				break;
-			}
-			case '[': {
-				
-				/* Place an object of the template's specified tval */
-				place_object(c, grid, c->depth, false, false, ORIGIN_SPECIAL,
-							 tval);
-				break;
-			}
-			case '1':
-			case '2':
-			case '3':
-			case '4':
-			case '5':
-			case '6': {
-				/* Check if this is chosen random door position */
-				doorpos = (int) (*t - '0');
-
-				if (doorpos == rnddoors)
-					place_secret_door(c, grid);
-				else
-					set_marked_granite(c, grid, SQUARE_WALL_SOLID);
+			break;
+		}
+		case '#': set_marked_granite(c, grid, SQUARE_WALL_SOLID); break;
+		case '+': place_closed_door(c, grid); break;
+		case '^': if (one_in_(4)) place_trap(c, grid, -1, c->depth); break;
+		case 'x': {
+
+			/* If optional walls are generated, put a wall in this square */
+			if (rndwalls)
+				set_marked_granite(c, grid, SQUARE_WALL_SOLID);
+			break;
+		}
+		case '(': {
 
-				break;
-			}
+			/* If optional walls are generated, put a door in this square */
+			if (rndwalls)
+				place_secret_door(c, grid);
+			break;
+		}
+		case ')': {
+			/* If no optional walls generated, put a door in this square */
+			if (!rndwalls)
+				place_secret_door(c, grid);
+			else
+				set_marked_granite(c, grid, SQUARE_WALL_SOLID);
+			break;
+		}
+		case '8': {
+			/* Put something nice in this square
+			 * Object (80%) or Stairs (20%) */
+			if (randint0(100) < 80 || dun->persist) {
+				place_object(c, grid, c->depth, false, false,
+							 ORIGIN_SPECIAL, 0);
+			} else {
+				place_random_stairs(c, grid, dun->quest);
 			}
+			/* Place nearby guards in second pass. */
+			break;
+		}
+		case '9': {
+			/* Everything is handled in the second pass. */
+			break;
+		}
+		case '[': {
+			
+			/* Place an object of the template's specified tval */
+			place_object(c, grid, c->depth, false, false, ORIGIN_SPECIAL,
+						 tval);
+			break;
+		}
+		case '1':
+		case '2':
+		case '3':
+		case '4':
+		case '5':
+		case '6': {
+			/* Check if this is chosen random door position */
+			doorpos = (int) (cell->glyph - '0');
+
+			if (doorpos == rnddoors)
+				place_secret_door(c, grid);
+			else
+				set_marked_granite(c, grid, SQUARE_WALL_SOLID);
 
-			/* Part of a room */
-			sqinfo_on(square(c, grid)->info, SQUARE_ROOM);
-			if (light)
-				sqinfo_on(square(c, grid)->info, SQUARE_GLOW);
+			break;
+		}
 		}
+
+		/* Part of a room */
+		sqinfo_on(square(c, grid)->info, SQUARE_ROOM);
+		if (light)
+			sqinfo_on(square(c, grid)->info, SQUARE_GLOW);
 	}
 	/*
 	 * Perform second pass for placement of monsters and objects at
 	 * unspecified locations after all the features are in place.
 	 */
-	for (t = data, dy = 0; dy < ymax && *t; dy++) {
-		for (dx = 0; dx < xmax && *t; dx++, t++) {
-			/* Extract the location */
-			struct loc grid = loc(dx, dy);
-
-			symmetry_transform(&grid, centre.y, centre.x,
-				ymax, xmax, rotate, reflect);
+	for (i = 0; i < room->n_late_cells; i++) {
+		const struct room_cell *cell = &room->late_cells[i];
+		/* Extract the location */
+		struct loc grid = loc(cell->x, cell->y);
+
+		symmetry_transform(&grid, centre.y, centre.x,
+			ymax, xmax, rotate, reflect);
+
+		/* Analyze the grid. */
+		switch (cell->glyph) {
+		case '#':
+			/* Check consistency with first pass. */
+			assert(square_isroom(c, grid) &&
+				square_isgranite(c, grid) &&
+				sqinfo_has(square(c, grid)->info,
+				SQUARE_WALL_SOLID));
+			/*
+			 * Convert to SQUARE_WALL_INNER if it does not
+			 * touch the outside of the room.
+			 */
+			if (count_neighbors(NULL, c, grid,
+					square_isroom, false) == 8) {
+				sqinfo_off(square(c, grid)->info,
+					SQUARE_WALL_SOLID);
+				sqinfo_on(square(c, grid)->info,
+					SQUARE_WALL_INNER);
+			}
+			break;
 
-			/* Analyze the grid. */
-			switch (*t) {
-			case '#':
-				/* Check consistency with first pass. */
-				assert(square_isroom(c, grid) &&
-					square_isgranite(c, grid) &&
-					sqinfo_has(square(c, grid)->info,
-					SQUARE_WALL_SOLID));
-				/*
-				 * Convert to SQUARE_WALL_INNER if it does not
-				 * touch the outside of the room.
-				 */
-				if (count_neighbors(NULL, c, grid,
-						square_isroom, false) == 8) {
-					sqinfo_off(square(c, grid)->info,
-						SQUARE_WALL_SOLID);
-					sqinfo_on(square(c, grid)->info,
-						SQUARE_WALL_INNER);
-				}
-				break;
+		case '8':
+			/* Check consistency with first pass. */
+			assert(square_isroom(c, grid) &&
+				(square_isfloor(c, grid) ||
+				square_isstairs(c, grid)));
 
-			case '8':
-				/* Check consistency with first pass. */
-				assert(square_isroom(c, grid) &&
-					(square_isfloor(c, grid) ||
-					square_isstairs(c, grid)));
+			/* Add some monsters to guard it. */
+			vault_monsters(c, grid, c->depth + 2,
+				randint0(2) + 3);
+			break;
 
-				/* Add some monsters to guard it. */
-				vault_monsters(c, grid, c->depth + 2,
-					randint0(2) + 3);
-				break;
+		case '9': {
+			/* Create some interesting stuff nearby. */
+			struct loc off2 = loc(2, -2);
+			struct loc off3 = loc(3, 3);
 
-			case '9': {
-				/* Create some interesting stuff nearby. */
-				struct loc off2 = loc(2, -2);
-				struct loc off3 = loc(3, 3);
+			/* Check consistency with first pass. */
+			assert(square_isroom(c, grid) &&
+				square_isfloor(c, grid));
 
-				/* Check consistency with first pass. */
-				assert(square_isroom(c, grid) &&
-					square_isfloor(c, grid));
-
-				/* Add a few monsters. */
-				vault_monsters(c, loc_diff(grid, off3),
-					c->depth + randint0(2), randint1(2));
-				vault_monsters(c, loc_sum(grid, off3),
-					c->depth + randint0(2), randint1(2));
+			/* Add a few monsters. */
+			vault_monsters(c, loc_diff(grid, off3),
+				c->depth + randint0(2), randint1(2));
+			vault_monsters(c, loc_sum(grid, off3),
+				c->depth + randint0(2), randint1(2));
 
-				/* And maybe a bit of treasure. */
-				if (one_in_(2)) {
-					vault_objects(c, loc_sum(grid, off2),
-						c->depth, 1 + randint0(2));
-				}
-				if (one_in_(2)) {
-					vault_objects(c, loc_diff(grid, off2),
-						c->depth, 1 + randint0(2));
-				}
-				break;
+			/* And maybe a bit of treasure. */
+			if (one_in_(2)) {
+				vault_objects(c, loc_sum(grid, off2),
+					c->depth, 1 + randint0(2));
 			}
-
-			default:
-				/* Everything was handled in the first pass. */
-				break;
+			if (one_in_(2)) {
+				vault_objects(c, loc_diff(grid, off2),
+					c->depth, 1 + randint0(2));
 			}
+			break;
+		}
+
+		default:
+			/* Everything was handled in the first pass. */
+			break;
 		}
 	}
 
@@ -1352,8 +1353,7 @@ static bool build_room_template_type(struct chunk *c, struct loc centre,
 
 	/* Build the room */
 	event_signal_string(EVENT_GEN_ROOM_CHOOSE_SUBTYPE, room->name);
-	if (!build_room_template(c, centre, room->hgt, room->wid, room->dor,
-			room->text, room->tval, room->flags))
+	if (!build_room_template(c, centre, room))
 		return false;
 
 	ROOM_LOG("Room template (%s)", room->name);
@@ -1362,7 +1362,7 @@ static bool build_room_template_type(struct chunk *c, struct loc centre,
 }
 
 /**
- * Build a vault from its string representation.
+ * Build a vault from its compiled layout.
  * \param c the chunk the room is being built in
  * \param centre the room centre; out of chunk centre invokes find_space()
  * \param v pointer to the vault template
@@ -1370,10 +1370,8 @@ static bool build_room_template_type(struct chunk *c, struct loc centre,
  */
 bool build_vault(struct chunk *c, struct loc centre, struct vault *v)
 {
-	const char *data = v->text;
 	int y1, x1, y2, x2;
-	int x, y, races_local = 0;
-	const char *t;
+	int i, races_local = 0;
 	char racial_symbol[30] = "";
 	bool icky;
 	int rotate, thgt, twid;
@@ -1414,292 +1412,285 @@ bool build_vault(struct chunk *c, struct loc centre, struct vault *v)
 	generate_mark(c, y1, x1, y2, x2, SQUARE_MON_RESTRICT);
 
 	/* Place dungeon features and objects */
-	for (t = data, y = 0; y < v->hgt && *t; y++) {
-		for (x = 0; x < v->wid && *t; x++, t++) {
-			struct loc grid = loc(x, y);
-
-			symmetry_transform(&grid, centre.y, centre.x, v->hgt,
-				v->wid, rotate, reflect);
-			assert(grid.x >= x1 && grid.x <= x2 &&
-				grid.y >= y1 && grid.y <= y2);
-
-			/* Skip non-grids */
-			if (*t == ' ') continue;
+	for (i = 0; i < v->n_cells; i++) {
+		const struct room_cell *cell = &v->cells[i];
+		struct loc grid = loc(cell->x, cell->y);
+
+		symmetry_transform(&grid, centre.y, centre.x, v->hgt,
+			v->wid, rotate, reflect);
+		assert(grid.x >= x1 && grid.x <= x2 &&
+			grid.y >= y1 && grid.y <= y2);
+
+		/* Lay down a floor */
+		square_set_feat(c, grid, FEAT_FLOOR);
+
+		/* Debugging assertion */
+		assert(square_isempty(c, grid));
+
+		/* By default vault squares are marked icky */
+		icky = true;
+
+		/* Analyze the grid */
+		switch (cell->glyph) {
+		case '%': {
+			/* In this case, the square isn't really part
+			 * of the vault, but rather is part of the
+			 * "door step" to the vault. We don't mark it
+			 * icky so that the tunneling code knows it's
+			 * allowed to remove this wall. */
+			set_marked_granite(c, grid, SQUARE_WALL_OUTER);
+			if (roomf_has(v->flags, ROOMF_FEW_ENTRANCES)) {
+				append_entrance(grid);
+			}
+			icky = false;
+			break;
+		}
+			/* Inner or non-tunnelable outside granite wall */
+		case '#': set_marked_granite(c, grid, SQUARE_WALL_SOLID); break;
+			/* Permanent wall */
+		case '@': square_set_feat(c, grid, FEAT_PERM); break;
+			/* Gold seam */
+		case '*': {
+			square_set_feat(c, grid, one_in_(2) ? FEAT_MAGMA_K :
+							FEAT_QUARTZ_K);
+			break;
+		}
+			/* Rubble */
+		case ':': {
+			square_set_feat(c, grid, one_in_(2) ? FEAT_PASS_RUBBLE :
+							FEAT_RUBBLE);
+			break;
+		}
+			/* Secret door */
+		case '+': place_secret_door(c, grid); break;
+			/* Trap */
+		case '^': if (one_in_(4)) place_trap(c, grid, -1, c->depth); break;
+			/* Treasure or a trap */
+		case '&': {
+			if (randint0(100) < 75) {
+				place_object(c, grid, c->depth, false, false, ORIGIN_VAULT,
+							 0);
+			} else if (one_in_(4)) {
+				place_trap(c, grid, -1, c->depth);
+			}
+			break;
+		}
+			/* Stairs */
+		case '<': {
+			if (dun->persist) break;
+			square_set_feat(c, grid, FEAT_LESS); break;
+		}
+		case '>': {
+			if (dun->persist) break;
+			/* No down stairs at bottom or on quests */
+			if (dun->quest || c->depth
+					>= z_info->max_depth - 1) {
+				square_set_feat(c, grid, FEAT_LESS);
+			} else {
+				square_set_feat(c, grid, FEAT_MORE);
+			}
+			break;
+		}
+			/* Lava */
+		case '`': square_set_feat(c, grid, FEAT_LAVA); break;
+			/* Included to allow simple inclusion of FA vaults */
+		case '/': /*square_set_feat(c, grid, FEAT_WATER)*/; break;
+		case ';': /*square_set_feat(c, grid, FEAT_TREE)*/; break;
+		}
 
-			/* Lay down a floor */
-			square_set_feat(c, grid, FEAT_FLOOR);
+		/* Part of a vault */
+		sqinfo_on(square(c, grid)->info, SQUARE_ROOM);
+		if (icky) sqinfo_on(square(c, grid)->info, SQUARE_VAULT);
+	}
 
-			/* Debugging assertion */
-			assert(square_isempty(c, grid));
 
-			/* By default vault squares are marked icky */
-			icky = true;
+	/* Place regular dungeon monsters and objects, convert inner walls */
+	for (i = 0; i < v->n_late_cells; i++) {
+		const struct room_cell *cell = &v->late_cells[i];
+		struct loc grid = loc(cell->x, cell->y);
+
+		symmetry_transform(&grid, centre.y, centre.x, v->hgt,
+			v->wid, rotate, reflect);
+		assert(grid.x >= x1 && grid.x <= x2 &&
+			grid.y >= y1 && grid.y <= y2);
+
+		/* Most alphabetic characters signify monster races. */
+		if (isalpha(cell->glyph) && (cell->glyph != 'x') &&
+				(cell->glyph != 'X')) {
+			/* If the symbol is not yet stored, ... */
+			if (!strchr(racial_symbol, cell->glyph)) {
+				/* ... store it for later processing. */
+				if (races_local < 30)
+					racial_symbol[races_local++] = cell->glyph;
+			}
+		}
 
-			/* Analyze the grid */
-			switch (*t) {
-			case '%': {
-				/* In this case, the square isn't really part
-				 * of the vault, but rather is part of the
-				 * "door step" to the vault. We don't mark it
-				 * icky so that the tunneling code knows it's
-				 * allowed to remove this wall. */
-				set_marked_granite(c, grid, SQUARE_WALL_OUTER);
-				if (roomf_has(v->flags, ROOMF_FEW_ENTRANCES)) {
-					append_entrance(grid);
+		/* Otherwise, analyze the symbol */
+		else
+			switch (cell->glyph) {
+				/* An ordinary monster, object (sometimes good), or trap. */
+			case '1': {
+				if (one_in_(2)) {
+					pick_and_place_monster(c, grid, c->depth , true, true,
+										   ORIGIN_DROP_VAULT);
+				} else if (one_in_(2)) {
+					place_object(c, grid, c->depth,
+								 one_in_(8) ? true : false, false,
+								 ORIGIN_VAULT, 0);
+				} else if (one_in_(4)) {
+					place_trap(c, grid, -1, c->depth);
 				}
-				icky = false;
 				break;
 			}
-				/* Inner or non-tunnelable outside granite wall */
-			case '#': set_marked_granite(c, grid, SQUARE_WALL_SOLID); break;
-				/* Permanent wall */
-			case '@': square_set_feat(c, grid, FEAT_PERM); break;
-				/* Gold seam */
-			case '*': {
-				square_set_feat(c, grid, one_in_(2) ? FEAT_MAGMA_K :
-								FEAT_QUARTZ_K);
+				/* Slightly out of depth monster. */
+			case '2': pick_and_place_monster(c, grid, c->depth + 5, true,
+											 true, ORIGIN_DROP_VAULT);
 				break;
-			}
-				/* Rubble */
-			case ':': {
-				square_set_feat(c, grid, one_in_(2) ? FEAT_PASS_RUBBLE :
-								FEAT_RUBBLE);
+				/* Slightly out of depth object. */
+			case '3': place_object(c, grid, c->depth + 3, false, false, 
+								   ORIGIN_VAULT, 0); break;
+				/* Monster and/or object */
+			case '4': {
+				if (one_in_(2))
+					pick_and_place_monster(c, grid, c->depth + 3, true, 
+										   true, ORIGIN_DROP_VAULT);
+				if (one_in_(2))
+					place_object(c, grid, c->depth + 7, false, false,
+								 ORIGIN_VAULT, 0);
 				break;
 			}
-				/* Secret door */
-			case '+': place_secret_door(c, grid); break;
-				/* Trap */
-			case '^': if (one_in_(4)) place_trap(c, grid, -1, c->depth); break;
-				/* Treasure or a trap */
-			case '&': {
-				if (randint0(100) < 75) {
-					place_object(c, grid, c->depth, false, false, ORIGIN_VAULT,
-								 0);
-				} else if (one_in_(4)) {
-					place_trap(c, grid, -1, c->depth);
-				}
+				/* Out of depth object. */
+			case '5': place_object(c, grid, c->depth + 7, false, false,
+								   ORIGIN_VAULT, 0); break;
+				/* Out of depth monster. */
+			case '6': pick_and_place_monster(c, grid, c->depth + 11, true,
+											 true, ORIGIN_DROP_VAULT);
+				break;
+				/* Very out of depth object. */
+			case '7': place_object(c, grid, c->depth + 15, false, false,
+								   ORIGIN_VAULT, 0); break;
+				/* Very out of depth monster. */
+			case '0': pick_and_place_monster(c, grid, c->depth + 20, true,
+											 true, ORIGIN_DROP_VAULT);
+				break;
+				/* Meaner monster, plus treasure */
+			case '9': {
+				pick_and_place_monster(c, grid, c->depth + 9, true, true,
+									   ORIGIN_DROP_VAULT);
+				place_object(c, grid, c->depth + 7, true, false,
+							 ORIGIN_VAULT, 0);
 				break;
 			}
-				/* Stairs */
-			case '<': {
-				if (dun->persist) break;
-				square_set_feat(c, grid, FEAT_LESS); break;
+				/* Nasty monster and treasure */
+			case '8': {
+				pick_and_place_monster(c, grid, c->depth + 40, true, true,
+									   ORIGIN_DROP_VAULT);
+				place_object(c, grid, c->depth + 20, true, true,
+							 ORIGIN_VAULT, 0);
+				break;
 			}
-			case '>': {
-				if (dun->persist) break;
-				/* No down stairs at bottom or on quests */
-				if (dun->quest || c->depth
-						>= z_info->max_depth - 1) {
-					square_set_feat(c, grid, FEAT_LESS);
-				} else {
-					square_set_feat(c, grid, FEAT_MORE);
+				/* A chest. */
+			case '~': place_object(c, grid, c->depth + 5, false, false,
+								   ORIGIN_VAULT, TV_CHEST); break;
+				/* Treasure. */
+			case '$': place_gold(c, grid, c->depth, ORIGIN_VAULT);break;
+				/* Armour. */
+			case ']': {
+				int	tval = 0, temp = one_in_(3) ? randint1(9) : randint1(8);
+				switch (temp) {
+				case 1: tval = TV_BOOTS; break;
+				case 2: tval = TV_GLOVES; break;
+				case 3: tval = TV_HELM; break;
+				case 4: tval = TV_CROWN; break;
+				case 5: tval = TV_SHIELD; break;
+				case 6: tval = TV_CLOAK; break;
+				case 7: tval = TV_SOFT_ARMOR; break;
+				case 8: tval = TV_HARD_ARMOR; break;
+				case 9: tval = TV_DRAG_ARMOR; break;
 				}
+				place_object(c, grid, c->depth + 3, true, false,
+							 ORIGIN_VAULT, tval);
 				break;
 			}
-				/* Lava */
-			case '`': square_set_feat(c, grid, FEAT_LAVA); break;
-				/* Included to allow simple inclusion of FA vaults */
-			case '/': /*square_set_feat(c, grid, FEAT_WATER)*/; break;
-			case ';': /*square_set_feat(c, grid, FEAT_TREE)*/; break;
-			}
-
-			/* Part of a vault */
-			sqinfo_on(square(c, grid)->info, SQUARE_ROOM);
-			if (icky) sqinfo_on(square(c, grid)->info, SQUARE_VAULT);
-		}
-	}
-
-
-	/* Place regular dungeon monsters and objects, convert inner walls */
-	for (t = data, y = 0; y < v->hgt && *t; y++) {
-		for (x = 0; x < v->wid && *t; x++, t++) {
-			struct loc grid = loc(x, y);
-
-			symmetry_transform(&grid, centre.y, centre.x, v->hgt,
-				v->wid, rotate, reflect);
-			assert(grid.x >= x1 && grid.x <= x2 &&
-				grid.y >= y1 && grid.y <= y2);
-
-			/* Hack -- skip "non-grids" */
-			if (*t == ' ') continue;
-
-			/* Most alphabetic characters signify monster races. */
-			if (isalpha(*t) && (*t != 'x') && (*t != 'X')) {
-				/* If the symbol is not yet stored, ... */
-				if (!strchr(racial_symbol, *t)) {
-					/* ... store it for later processing. */
-					if (races_local < 30)
-						racial_symbol[races_local++] = *t;
+				/* Weapon. */
+			case '|': {
+				int	tval = 0, temp = randint1(4);
+				switch (temp) {
+				case 1: tval = TV_SWORD; break;
+				case 2: tval = TV_POLEARM; break;
+				case 3: tval = TV_HAFTED; break;
+				case 4: tval = TV_BOW; break;
 				}
+				place_object(c, grid, c->depth + 3, true, false,
+							 ORIGIN_VAULT, tval);
+				break;
 			}
-
-			/* Otherwise, analyze the symbol */
-			else
-				switch (*t) {
-					/* An ordinary monster, object (sometimes good), or trap. */
-				case '1': {
-					if (one_in_(2)) {
-						pick_and_place_monster(c, grid, c->depth , true, true,
-											   ORIGIN_DROP_VAULT);
-					} else if (one_in_(2)) {
-						place_object(c, grid, c->depth,
-									 one_in_(8) ? true : false, false,
-									 ORIGIN_VAULT, 0);
-					} else if (one_in_(4)) {
-						place_trap(c, grid, -1, c->depth);
-					}
-					break;
-				}
-					/* Slightly out of depth monster. */
-				case '2': pick_and_place_monster(c, grid, c->depth + 5, true,
-												 true, ORIGIN_DROP_VAULT);
-					break;
-					/* Slightly out of depth object. */
-				case '3': place_object(c, grid, c->depth + 3, false, false, 
-									   ORIGIN_VAULT, 0); break;
-					/* Monster and/or object */
-				case '4': {
-					if (one_in_(2))
-						pick_and_place_monster(c, grid, c->depth + 3, true, 
-											   true, ORIGIN_DROP_VAULT);
-					if (one_in_(2))
-						place_object(c, grid, c->depth + 7, false, false,
-									 ORIGIN_VAULT, 0);
-					break;
-				}
-					/* Out of depth object. */
-				case '5': place_object(c, grid, c->depth + 7, false, false,
-									   ORIGIN_VAULT, 0); break;
-					/* Out of depth monster. */
-				case '6': pick_and_place_monster(c, grid, c->depth + 11, true,
-												 true, ORIGIN_DROP_VAULT);
-					break;
-					/* Very out of depth object. */
-				case '7': place_object(c, grid, c->depth + 15, false, false,
-									   ORIGIN_VAULT, 0); break;
-					/* Very out of depth monster. */
-				case '0': pick_and_place_monster(c, grid, c->depth + 20, true,
-												 true, ORIGIN_DROP_VAULT);
-					break;
-					/* Meaner monster, plus treasure */
-				case '9': {
-					pick_and_place_monster(c, grid, c->depth + 9, true, true,
-										   ORIGIN_DROP_VAULT);
-					place_object(c, grid, c->depth + 7, true, false,
-								 ORIGIN_VAULT, 0);
-					break;
-				}
-					/* Nasty monster and treasure */
-				case '8': {
-					pick_and_place_monster(c, grid, c->depth + 40, true, true,
-										   ORIGIN_DROP_VAULT);
-					place_object(c, grid, c->depth + 20, true, true,
-								 ORIGIN_VAULT, 0);
-					break;
-				}
-					/* A chest. */
-				case '~': place_object(c, grid, c->depth + 5, false, false,
-									   ORIGIN_VAULT, TV_CHEST); break;
-					/* Treasure. */
-				case '$': place_gold(c, grid, c->depth, ORIGIN_VAULT);break;
-					/* Armour. */
-				case ']': {
-					int	tval = 0, temp = one_in_(3) ? randint1(9) : randint1(8);
-					switch (temp) {
-					case 1: tval = TV_BOOTS; break;
-					case 2: tval = TV_GLOVES; break;
-					case 3: tval = TV_HELM; break;
-					case 4: tval = TV_CROWN; break;
-					case 5: tval = TV_SHIELD; break;
-					case 6: tval = TV_CLOAK; break;
-					case 7: tval = TV_SOFT_ARMOR; break;
-					case 8: tval = TV_HARD_ARMOR; break;
-					case 9: tval = TV_DRAG_ARMOR; break;
-					}
-					place_object(c, grid, c->depth + 3, true, false,
-								 ORIGIN_VAULT, tval);
-					break;
-				}
-					/* Weapon. */
-				case '|': {
-					int	tval = 0, temp = randint1(4);
-					switch (temp) {
-					case 1: tval = TV_SWORD; break;
-					case 2: tval = TV_POLEARM; break;
-					case 3: tval = TV_HAFTED; break;
-					case 4: tval = TV_BOW; break;
-					}
-					place_object(c, grid, c->depth + 3, true, false,
-								 ORIGIN_VAULT, tval);
-					break;
-				}
-					/* Ring. */
-				case '=': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT, TV_RING); break;
-					/* Amulet. */
-				case '"': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT, TV_AMULET); break;
-					/* Potion. */
-				case '!': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT, TV_POTION); break;
-					/* Scroll. */
-				case '?': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT, TV_SCROLL); break;
-					/* Staff. */
-				case '_': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT, TV_STAFF); break;
-					/* Wand or rod. */
-				case '-': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT,
-									   one_in_(2) ? TV_WAND : TV_ROD);
-					break;
-					/* Food or mushroom. */
-				case ',': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT, TV_FOOD); break;
-					/* Inner or non-tunnelable outside granite wall */
-				case '#': {
-					/* Check consistency with first pass. */
-					assert(square_isroom(c, grid) &&
-						square_isvault(c, grid) &&
-						square_isgranite(c, grid) &&
-						sqinfo_has(square(c, grid)->info, SQUARE_WALL_SOLID));
-					/*
-					 * Convert to SQUARE_WALL_INNER if it
-					 * does not touch the outside of the
-					 * vault.
-					 */
-					if (count_neighbors(NULL, c, grid,
-							square_isroom, false) == 8) {
-						sqinfo_off(square(c, grid)->info,
-							SQUARE_WALL_SOLID);
-						sqinfo_on(square(c, grid)->info,
-							SQUARE_WALL_INNER);
-					}
-					break;
-				}
-					/* Permanent wall */
-				case '@': {
-					/* Check consistency with first pass. */
-					assert(square_isroom(c, grid) &&
-						square_isvault(c, grid) &&
-						square_isperm(c, grid));
-					/*
-					 * Mark as SQUARE_WALL_INNER if it does
-					 * not touch the outside of the vault.
-					 */
-					if (count_neighbors(NULL, c, grid,
-							square_isroom, false) == 8) {
-						sqinfo_on(square(c, grid)->info,
-							SQUARE_WALL_INNER);
-					}
-					break;
+				/* Ring. */
+			case '=': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT, TV_RING); break;
+				/* Amulet. */
+			case '"': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT, TV_AMULET); break;
+				/* Potion. */
+			case '!': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT, TV_POTION); break;
+				/* Scroll. */
+			case '?': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT, TV_SCROLL); break;
+				/* Staff. */
+			case '_': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT, TV_STAFF); break;
+				/* Wand or rod. */
+			case '-': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT,
+								   one_in_(2) ? TV_WAND : TV_ROD);
+				break;
+				/* Food or mushroom. */
+			case ',': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT, TV_FOOD); break;
+				/* Inner or non-tunnelable outside granite wall */
+			case '#': {
+				/* Check consistency with first pass. */
+				assert(square_isroom(c, grid) &&
+					square_isvault(c, grid) &&
+					square_isgranite(c, grid) &&
+					sqinfo_has(square(c, grid)->info, SQUARE_WALL_SOLID));
+				/*
+				 * Convert to SQUARE_WALL_INNER if it
+				 * does not touch the outside of the
+				 * vault.
+				 */
+				if (count_neighbors(NULL, c, grid,
+						square_isroom, false) == 8) {
+					sqinfo_off(square(c, grid)->info,
+						SQUARE_WALL_SOLID);
+					sqinfo_on(square(c, grid)->info,
+						SQUARE_WALL_INNER);
 				}
+				break;
+			}
+				/* Permanent wall */
+			case '@': {
+				/* Check consistency with first pass. */
+				assert(square_isroom(c, grid) &&
+					square_isvault(c, grid) &&
+					square_isperm(c, grid));
+				/*
+				 * Mark as SQUARE_WALL_INNER if it does
+				 * not touch the outside of the vault.
+				 */
+				if (count_neighbors(NULL, c, grid,
+						square_isroom, false) == 8) {
+					sqinfo_on(square(c, grid)->info,
+						SQUARE_WALL_INNER);
 				}
-		}
+				break;
+			}
+			}
 	}
 
 	/* Place specified monsters */
-	get_vault_monsters(c, racial_symbol, v->typ, data, y1, y2, x1, x2);
+	get_vault_monsters(c, racial_symbol, v, centre, rotate, reflect);
 
 	return true;
 }
@@ -633,6 +633,7 @@ void alloc_stairs(struct chunk *c, int feat, int num, int minsep, bool sepany,
 	struct loc *av;
 	int *state;
 
+	event_signal_string(EVENT_GEN_STAGE_START, "allocate");
 	nav = 0;
 	if (minsep > 0) {
 		/*
@@ -729,6 +730,7 @@ void alloc_stairs(struct chunk *c, int feat, int num, int minsep, bool sepany,
 
 	mem_free(state);
 	mem_free(av);
+	event_signal_string(EVENT_GEN_STAGE_END, "allocate");
 }
 
 
@@ -748,10 +750,13 @@ int alloc_objects(struct chunk *c, int set, int typ, int num, int depth,
 		uint8_t origin)
 {
 	int k, l = 0;
+
+	event_signal_string(EVENT_GEN_STAGE_START, "allocate");
 	for (k = 0; k < num; k++) {
 		bool ok = alloc_object(c, set, typ, depth, origin);
 		if (!ok) l++;
 	}
+	event_signal_string(EVENT_GEN_STAGE_END, "allocate");
 	return l;
 }
 
@@ -55,8 +55,13 @@
 struct pit_profile *pit_info;
 struct vault *vaults;
 static struct cave_profile *cave_profiles;
+static const struct cave_profile *forced_profile;
 struct dun_data *dun;
 struct room_template *room_templates;
+struct vault_pick *vault_picks;
+int n_vault_picks;
+struct room_template_pick *room_template_picks;
+int n_room_template_picks;
 
 static const struct {
 	const char *name;
@@ -301,6 +306,7 @@ static void cleanup_profile(void)
 		string_free((char *) cave_profiles[i].name);
 	}
 	mem_free(cave_profiles);
+	forced_profile = NULL;
 }
 
 static struct file_parser profile_parser = {
@@ -312,6 +318,62 @@ static struct file_parser profile_parser = {
 };
 
 
+/**
+ * Turn the text of a vault or room template into the list of its grids which
+ * are not blank, in the order they come in the text, so that building it does
+ * not have to read the text again.  The grids which the builder looks at again
+ * once everything is in place go into a second, shorter list.
+ * \param text is the grid by grid description
+ * \param hgt is the height of the template
+ * \param wid is the width of the template
+ * \param is_late says which glyphs need the second pass
+ * \param cells is set to the list of grids which are not blank
+ * \param n_cells is set to the length of that list
+ * \param late_cells is set to the list of grids for the second pass
+ * \param n_late_cells is set to the length of that list
+ */
+static void compile_room_cells(const char *text, int hgt, int wid,
+		bool (*is_late)(char glyph), struct room_cell **cells, int *n_cells,
+		struct room_cell **late_cells, int *n_late_cells)
+{
+	const char *t;
+	int x, y, n = 0, n_late = 0;
+
+	*cells = NULL;
+	*late_cells = NULL;
+	if (!text) {
+		*n_cells = 0;
+		*n_late_cells = 0;
+		return;
+	}
+	for (t = text, y = 0; y < hgt && *t; y++) {
+		for (x = 0; x < wid && *t; x++, t++) {
+			if (*t == ' ') continue;
+			n++;
+			if (is_late(*t)) n_late++;
+		}
+	}
+	if (n) *cells = mem_alloc(n * sizeof(**cells));
+	if (n_late) *late_cells = mem_alloc(n_late * sizeof(**late_cells));
+	*n_cells = n;
+	*n_late_cells = n_late;
+
+	n = 0;
+	n_late = 0;
+	for (t = text, y = 0; y < hgt && *t; y++) {
+		for (x = 0; x < wid && *t; x++, t++) {
+			struct room_cell cell;
+
+			if (*t == ' ') continue;
+			cell.y = y;
+			cell.x = x;
+			cell.glyph = *t;
+			(*cells)[n++] = cell;
+			if (is_late(*t)) (*late_cells)[n_late++] = cell;
+		}
+	}
+}
+
 /**
  * Parsing functions for room_template.txt
  */
@@ -447,19 +509,70 @@ static errr run_parse_room(struct parser *p) {
 	return parse_file_quit_not_found(p, "room_template");
 }
 
+/**
+ * Glyphs in room templates which build_room_template() looks at again after
+ * all the terrain is in place
+ */
+static bool room_glyph_is_late(char glyph)
+{
+	return glyph == '#' || glyph == '8' || glyph == '9';
+}
+
 static errr finish_parse_room(struct parser *p) {
+	struct room_template *t;
+	int i;
+
 	room_templates = parser_priv(p);
 	parser_destroy(p);
+
+	/* Compile the layouts, and group the rooms by type and rating */
+	room_template_picks = NULL;
+	n_room_template_picks = 0;
+	for (t = room_templates; t; t = t->next) {
+		struct room_template_pick *pick;
+
+		compile_room_cells(t->text, t->hgt, t->wid, room_glyph_is_late,
+			&t->cells, &t->n_cells, &t->late_cells,
+			&t->n_late_cells);
+
+		for (i = 0; i < n_room_template_picks; i++) {
+			if (room_template_picks[i].typ == t->typ &&
+					room_template_picks[i].rat == t->rat) break;
+		}
+		if (i == n_room_template_picks) {
+			room_template_picks = mem_realloc(room_template_picks,
+				(i + 1) * sizeof(*room_template_picks));
+			room_template_picks[i].typ = t->typ;
+			room_template_picks[i].rat = t->rat;
+			room_template_picks[i].rooms = NULL;
+			room_template_picks[i].n_rooms = 0;
+			n_room_template_picks++;
+		}
+		pick = &room_template_picks[i];
+		pick->rooms = mem_realloc(pick->rooms,
+			(pick->n_rooms + 1) * sizeof(*pick->rooms));
+		pick->rooms[pick->n_rooms++] = t;
+	}
 	return 0;
 }
 
 static void cleanup_room(void)
 {
 	struct room_template *t, *next;
+	int i;
+
+	for (i = 0; i < n_room_template_picks; i++) {
+		mem_free(room_template_picks[i].rooms);
+	}
+	mem_free(room_template_picks);
+	room_template_picks = NULL;
+	n_room_template_picks = 0;
 	for (t = room_templates; t; t = next) {
 		next = t->next;
 		mem_free(t->name);
 		mem_free(t->text);
+		mem_free(t->cells);
+		mem_free(t->late_cells);
 		mem_free(t);
 	}
 }
@@ -611,20 +724,73 @@ static errr run_parse_vault(struct parser *p) {
 	return parse_file_quit_not_found(p, "vault");
 }
 
+/**
+ * Glyphs in vaults which build_vault() looks at again after all the terrain
+ * is in place:  monsters, objects and walls which may become inner walls
+ */
+static bool vault_glyph_is_late(char glyph)
+{
+	if (isalpha((unsigned char) glyph)) {
+		return glyph != 'x' && glyph != 'X';
+	}
+	return glyph != '\0' &&
+		strchr("0123456789~$]|=\"!?_-,#@", glyph) != NULL;
+}
+
 static errr finish_parse_vault(struct parser *p) {
+	struct vault *v;
+	int i;
+
 	vaults = parser_priv(p);
 	parser_destroy(p);
+
+	/* Compile the layouts, and group the vaults by type */
+	vault_picks = NULL;
+	n_vault_picks = 0;
+	for (v = vaults; v; v = v->next) {
+		struct vault_pick *pick;
+
+		compile_room_cells(v->text, v->hgt, v->wid, vault_glyph_is_late,
+			&v->cells, &v->n_cells, &v->late_cells,
+			&v->n_late_cells);
+
+		for (i = 0; i < n_vault_picks; i++) {
+			if (streq(vault_picks[i].typ, v->typ)) break;
+		}
+		if (i == n_vault_picks) {
+			vault_picks = mem_realloc(vault_picks,
+				(i + 1) * sizeof(*vault_picks));
+			vault_picks[i].typ = v->typ;
+			vault_picks[i].vaults = NULL;
+			vault_picks[i].n_vaults = 0;
+			n_vault_picks++;
+		}
+		pick = &vault_picks[i];
+		pick->vaults = mem_realloc(pick->vaults,
+			(pick->n_vaults + 1) * sizeof(*pick->vaults));
+		pick->vaults[pick->n_vaults++] = v;
+	}
 	return 0;
 }
 
 static void cleanup_vault(void)
 {
 	struct vault *v, *next;
+	int i;
+
+	for (i = 0; i < n_vault_picks; i++) {
+		mem_free(vault_picks[i].vaults);
+	}
+	mem_free(vault_picks);
+	vault_picks = NULL;
+	n_vault_picks = 0;
 	for (v = vaults; v; v = next) {
 		next = v->next;
 		mem_free(v->name);
 		mem_free(v->typ);
 		mem_free(v->text);
+		mem_free(v->cells);
+		mem_free(v->late_cells);
 		mem_free(v);
 	}
 }
@@ -830,6 +996,11 @@ static const struct cave_profile *choose_profile(struct player *p)
 		if (profile) return profile;
 	}
 
+	/* Use the profile set by force_level_profile(), if any */
+	if (forced_profile && p->depth) {
+		return forced_profile;
+	}
+
 	/* Make the profile choice */
 	if (p->depth == 0) {
 		profile = find_cave_profile("town");
@@ -1152,6 +1323,7 @@ static struct chunk *cave_generate(struct player *p, int height, int width)
 				msg("Generation restarted: %s.", error);
 			}
 			cleanup_dun_data(dun);
+			event_signal_string(EVENT_GEN_LEVEL_RESTART, error);
 			event_signal_flag(EVENT_GEN_LEVEL_END, false);
 			continue;
 		}
@@ -1212,6 +1384,7 @@ static struct chunk *cave_generate(struct player *p, int height, int width)
 			}
 			uncreate_artifacts(chunk);
 			cave_clear(chunk, p);
+			event_signal_string(EVENT_GEN_LEVEL_RESTART, error);
 			event_signal_flag(EVENT_GEN_LEVEL_END, false);
 		}
 
@@ -1603,6 +1776,23 @@ const char *get_level_profile_name_from_index(int i)
 		cave_profiles[i].name : NULL;
 }
 
+/**
+ * Make every later dungeon level (not the town) use the named profile rather
+ * than choosing one at random; for benchmarking and testing the generators.
+ * \param name is the name of the profile or NULL to go back to random
+ * choices.
+ * \return false if name is not NULL and does not match any profile.
+ */
+bool force_level_profile(const char *name)
+{
+	if (!name) {
+		forced_profile = NULL;
+		return true;
+	}
+	forced_profile = find_cave_profile(name);
+	return forced_profile != NULL;
+}
+
 /**
  * The generate module, which initialises template rooms and vaults
  * Should it clean up?
@@ -258,6 +258,16 @@ struct room_profile {
 };
 
 
+/**
+ * A grid of a vault or room template which is not blank, with its place in
+ * the template before any symmetry transform
+ */
+struct room_cell {
+    uint8_t y, x;
+    char glyph;
+};
+
+
 /*
  * Information about vault generation
  */
@@ -278,6 +288,20 @@ struct vault {
 
     uint8_t min_lev;		/*!< Minimum allowable level, if specified. */
     uint8_t max_lev;		/*!< Maximum allowable level, if specified. */
+
+    struct room_cell *cells;	/*!< Grids which are not blank, in order */
+    int n_cells;
+    struct room_cell *late_cells;	/*!< Grids needing the second pass */
+    int n_late_cells;
+};
+
+/**
+ * The vaults of one type, to pick from at random
+ */
+struct vault_pick {
+    const char *typ;
+    struct vault **vaults;
+    int n_vaults;
 };
 
 
@@ -301,6 +325,21 @@ struct room_template {
     uint8_t wid;		/*!< Room width */
     uint8_t dor;		/*!< Random door options */
     uint8_t tval;		/*!< tval for objects in this room */
+
+    struct room_cell *cells;	/*!< Grids which are not blank, in order */
+    int n_cells;
+    struct room_cell *late_cells;	/*!< Grids needing the second pass */
+    int n_late_cells;
+};
+
+/**
+ * The room templates of one type and rating, to pick from at random
+ */
+struct room_template_pick {
+    uint8_t typ;
+    uint8_t rat;
+    struct room_template **rooms;
+    int n_rooms;
 };
 
 /**
@@ -315,6 +354,10 @@ struct room_template {
 extern struct dun_data *dun;
 extern struct vault *vaults;
 extern struct room_template *room_templates;
+extern struct vault_pick *vault_picks;
+extern int n_vault_picks;
+extern struct room_template_pick *room_template_picks;
+extern int n_room_template_picks;
 
 /* generate.c */
 void prepare_next_level(struct player *p);
@@ -323,6 +366,7 @@ int get_room_builder_index_from_name(const char *name);
 const char *get_room_builder_name_from_index(int i);
 int get_level_profile_index_from_name(const char *name);
 const char *get_level_profile_name_from_index(int i);
+bool force_level_profile(const char *name);
 
 /* gen-cave.c */
 struct chunk *town_gen(struct player *p, int min_height, int min_width,
@@ -454,8 +498,9 @@ bool mon_restrict(const char *monster_type, int depth,
 	int current_depth, bool unique_ok);
 void spread_monsters(struct chunk *c, const char *type, int depth, int num, 
 	int y0, int x0, int dy, int dx, uint8_t origin);
-void get_vault_monsters(struct chunk *c, char racial_symbol[], char *vault_type,
-						const char *data, int y1, int y2, int x1, int x2);
+void get_vault_monsters(struct chunk *c, char racial_symbol[],
+		const struct vault *v, struct loc corner, int rotate,
+		bool reflect);
 void get_chamber_monsters(struct chunk *c, int y1, int x1, int y2, int x2, char *name, int area);
 
 
@@ -4531,6 +4531,7 @@ void cleanup_angband(void)
 
 	monster_list_finalize();
 	object_list_finalize();
+	object_pool_free();
 
 	cleanup_game_constants();
 
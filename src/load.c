@@ -171,8 +171,7 @@ static struct object *rd_item(void)
 	}
 	rd_byte(&obj->notice);
 
-	for (i = 0; i < of_size; i++)
-		rd_byte(&obj->flags[i]);
+	rd_bytes(obj->flags, of_size);
 
 	for (i = 0; i < obj_mod_max; i++) {
 		rd_s16b(&obj->modifiers[i]);
@@ -291,15 +290,12 @@ static bool rd_monster(struct chunk *c, struct monster *mon)
 	rd_byte(&mon->energy);
 	rd_byte(&tmp8u);
 
-	for (j = 0; j < tmp8u; j++)
-		rd_s16b(&mon->m_timed[j]);
+	rd_s16b_array(mon->m_timed, tmp8u);
 
 	/* Read and extract the flag */
-	for (j = 0; j < mflag_size; j++)
-		rd_byte(&mon->mflag[j]);
+	rd_bytes(mon->mflag, mflag_size);
 
-	for (j = 0; j < of_size; j++)
-		rd_byte(&mon->known_pstate.flags[j]);
+	rd_bytes(mon->known_pstate.flags, of_size);
 
 	for (j = 0; j < elem_max; j++)
 		rd_s16b(&mon->known_pstate.el_info[j].res_level);
@@ -358,7 +354,6 @@ static bool rd_monster(struct chunk *c, struct monster *mon)
  */
 static void rd_trap(struct trap *trap)
 {
-	int i;
 	uint8_t tmp8u;
 	char buf[80];
 
@@ -374,8 +369,7 @@ static void rd_trap(struct trap *trap)
 	rd_byte(&trap->power);
 	rd_byte(&trap->timeout);
 
-	for (i = 0; i < trf_size; i++)
-		rd_byte(&trap->flags[i]);
+	rd_bytes(trap->flags, trf_size);
 }
 
 /**
@@ -733,10 +727,10 @@ int rd_player(void)
 		return -1;
 	}
 
-	for (i = 0; i < stat_max; i++) rd_s16b(&player->stat_max[i]);
-	for (i = 0; i < stat_max; i++) rd_s16b(&player->stat_cur[i]);
-	for (i = 0; i < stat_max; i++) rd_s16b(&player->stat_map[i]);
-	for (i = 0; i < stat_max; i++) rd_s16b(&player->stat_birth[i]);
+	rd_s16b_array(player->stat_max, stat_max);
+	rd_s16b_array(player->stat_cur, stat_max);
+	rd_s16b_array(player->stat_map, stat_max);
+	rd_s16b_array(player->stat_birth, stat_max);
 
 	rd_s16b(&player->ht_birth);
 	rd_s16b(&player->wt_birth);
@@ -819,16 +813,14 @@ int rd_player(void)
 
 	if (num <= TMD_MAX) {
 		/* Read all the effects */
-		for (i = 0; i < num; i++)
-			rd_s16b(&player->timed[i]);
+		rd_s16b_array(player->timed, num);
 
 		/* Initialize any entries not read */
 		if (num < TMD_MAX)
 			memset(player->timed + num, 0, (TMD_MAX - num) * sizeof(int16_t));
 	} else {
 		/* Probably in trouble anyway */
-		for (i = 0; i < TMD_MAX; i++)
-			rd_s16b(&player->timed[i]);
+		rd_s16b_array(player->timed, TMD_MAX);
 
 		/* Discard unused entries */
 		strip_bytes(2 * (num - TMD_MAX));
@@ -865,8 +857,7 @@ int rd_ignore(void)
 	if (tmp8u != ignore_size) {
 		strip_bytes(tmp8u);
 	} else {
-		for (i = 0; i < ignore_size; i++)
-			rd_byte(&ignore_level[i]);
+		rd_bytes(ignore_level, ignore_size);
 	}
 
 	/* Read the number of saved ego-item */
@@ -886,8 +877,7 @@ int rd_ignore(void)
 			e_info[i].everseen = (flags & 0x02) ? true : false;
 
 			/* Read and extract the ignore flags */
-			for (j = 0; j < itype_size; j++)
-				rd_byte(&itypes[j]);
+			rd_bytes(itypes, itype_size);
 
 			/* If number of ignore types has changed, don't set anything */
 			if (itype_size == ITYPE_SIZE) {
@@ -989,15 +979,14 @@ int rd_misc(void)
 			activate_randart_file();
 			run_parser(&randart_parser);
 		} else {
-			do_randart(seed_randart, true);
+			do_randart(seed_randart, true, false);
 		}
 		deactivate_randart_file();
 	}
 
 	/* Property knowledge */
 	/* Flags */
-	for (i = 0; i < OF_SIZE; i++)
-		rd_byte(&player->obj_k->flags[i]);
+	rd_bytes(player->obj_k->flags, OF_SIZE);
 
 	/* Modifiers */
 	for (i = 0; i < OBJ_MOD_MAX; i++) {
@@ -1070,7 +1059,6 @@ int rd_artifacts(void)
 
 int rd_player_hp(void)
 {
-	int i;
 	uint16_t tmp16u;
 
 	/* Read the player_hp array */
@@ -1081,8 +1069,7 @@ int rd_player_hp(void)
 	}
 
 	/* Read the player_hp array */
-	for (i = 0; i < tmp16u; i++)
-		rd_s16b(&player->player_hp[i]);
+	rd_s16b_array(player->player_hp, tmp16u);
 
 	return 0;
 }
@@ -1109,8 +1096,7 @@ int rd_player_spells(void)
 	player_spells_init(player);
 	
 	/* Read the spell flags */
-	for (i = 0; i < tmp16u; i++)
-		rd_byte(&player->spell_flags[i]);
+	rd_bytes(player->spell_flags, tmp16u);
 	
 	/* Read the spell order */
 	for (i = 0, cnt = 0; i < tmp16u; i++, cnt++)
@@ -1210,18 +1196,44 @@ static int rd_stores_aux(rd_item_t rd_item_version)
 			"different than expected (%u).", tmp16u,
 			z_info->store_max));
 	}
+
+	/* Store maintenance (stores block v2+); older stores are up to date */
+	store_owed_num = 0;
+	if (rd_loaded_version() >= 2) {
+		uint16_t owed_num;
+
+		rd_u32b(&store_day);
+		rd_u32b(&store_seed);
+		rd_u16b(&owed_num);
+		for (i = 0; i < owed_num; i++) {
+			uint32_t last_day;
+			int16_t depth;
+
+			rd_u32b(&last_day);
+			rd_s16b(&depth);
+			store_owe_days(last_day, depth);
+		}
+	} else {
+		store_day = 0;
+		store_seed = randint0(0x10000000);
+	}
+
 	for (i = 0; i < tmp16u; i++) {
 		struct store *store = (i < z_info->store_max) ?
 			 &stores[i] : NULL;
 		uint8_t own, num;
+		uint32_t maint_day = store_day;
 
 		/* Read the basic info */
 		rd_byte(&own);
 		rd_byte(&num);
+		if (rd_loaded_version() >= 2)
+			rd_u32b(&maint_day);
 
 		/* XXX: refactor into store.c */
 		if (store) {
 			store->owner = store_ownerbyidx(store, own);
+			store->maint_day = maint_day;
 		}
 
 		/* Read the items */
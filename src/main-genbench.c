@@ -0,0 +1,558 @@
+/**
+ * \file main-genbench.c
+ * \brief Benchmark level generation from the command line
+ *
+ * Copyright (c) 2026 The Angband developers
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#include "angband.h"
+
+#ifdef USE_GENBENCH
+
+#include "game-event.h"
+#include "generate.h"
+#include "init.h"
+#include "main.h"
+#include "mon-make.h"
+#include "player-birth.h"
+#include "player-util.h"
+#include <sys/resource.h>
+#include <time.h>
+
+/* Default number of levels for each profile and depth */
+#define GENBENCH_DEFAULT_COUNT 20
+
+/* Most depths and profiles that may be given on the command line */
+#define GENBENCH_MAX_DEPTHS 64
+#define GENBENCH_MAX_PROFILES 32
+
+/* Deepest nesting of generation stages that is tracked */
+#define GENBENCH_MAX_NEST 16
+
+/* Most distinct restart reasons that are kept for one profile and depth */
+#define GENBENCH_MAX_REASONS 16
+
+/**
+ * The stages that generation time is split across; time not spent in any of
+ * them is put down to GB_STAGE_OTHER.
+ */
+enum {
+	GB_STAGE_OTHER,
+	GB_STAGE_ROOMS,
+	GB_STAGE_TUNNELS,
+	GB_STAGE_CONNECT,
+	GB_STAGE_ALLOCATE,
+	GB_STAGE_MAX
+};
+
+static const char *stage_names[GB_STAGE_MAX] = {
+	"other", "rooms", "tunnels", "connect", "allocate"
+};
+
+/**
+ * Results for one profile at one depth
+ */
+struct genbench_case {
+	const char *profile;
+	int depth;
+	int levels;
+	int tries;
+	clock_t ticks;
+	clock_t stage_ticks[GB_STAGE_MAX];
+	int n_reasons;
+	char *reasons[GENBENCH_MAX_REASONS];
+	int reason_counts[GENBENCH_MAX_REASONS];
+	/* The seeds of the slowest level and of the one needing most tries */
+	uint32_t slowest_seed, most_tries_seed;
+	clock_t slowest_ticks;
+	int most_tries;
+};
+
+/**
+ * What the event handlers need to attribute time to the right stage
+ */
+static struct {
+	struct genbench_case *curr;
+	int stack[GENBENCH_MAX_NEST];
+	int depth;
+	clock_t mark;
+	int tries;
+} gb;
+
+const char help_genbench[] =
+	"Level generation benchmark mode, subopts\n"
+	"              -n count    Generate count levels for each profile\n"
+	"                          and depth (default 20)\n"
+	"              -d depths   Comma-separated list of depths (default\n"
+	"                          5,15,30,50,75,95)\n"
+	"              -p profiles Comma-separated list of profile names\n"
+	"                          (default all but the town)\n"
+	"              -s seed     Base seed (hexadecimal value; no leading\n"
+	"                          0x; default 0)\n"
+	"              -o fname    Write the JSON results to fname rather\n"
+	"                          than standard output";
+
+/**
+ * Charge the time since the last mark to whatever stage is innermost, and
+ * move the mark on.
+ */
+static void charge_stage(void)
+{
+	clock_t now = clock();
+	int stage = (gb.depth > 0) ?
+		gb.stack[MIN(gb.depth, GENBENCH_MAX_NEST) - 1] : GB_STAGE_OTHER;
+
+	if (gb.curr) {
+		gb.curr->stage_ticks[stage] += now - gb.mark;
+	}
+	gb.mark = now;
+}
+
+/**
+ * Enter a stage.  Stages nested more than GENBENCH_MAX_NEST deep are only
+ * counted, and their time goes to the deepest stage which was recorded.
+ */
+static void push_stage(int stage)
+{
+	charge_stage();
+	if (gb.depth < GENBENCH_MAX_NEST) {
+		gb.stack[gb.depth] = stage;
+	}
+	++gb.depth;
+}
+
+static void pop_stage(void)
+{
+	charge_stage();
+	if (gb.depth > 0) {
+		--gb.depth;
+	}
+}
+
+static int stage_from_name(const char *name)
+{
+	int i;
+
+	for (i = 0; i < GB_STAGE_MAX; ++i) {
+		/* Event names are singular; "tunnel" for "tunnels" */
+		if (name && prefix(stage_names[i], name)) return i;
+	}
+	return GB_STAGE_OTHER;
+}
+
+static void genbench_handle_level_start(game_event_type et,
+		game_event_data *ed, void *ud)
+{
+	/* Restarted levels may leave stages open; they no longer matter */
+	charge_stage();
+	gb.depth = 0;
+	++gb.tries;
+}
+
+static void genbench_handle_restart(game_event_type et, game_event_data *ed,
+		void *ud)
+{
+	struct genbench_case *gc = gb.curr;
+	const char *reason = (ed->string) ? ed->string : "unknown";
+	int i;
+
+	if (!gc) return;
+	for (i = 0; i < gc->n_reasons; ++i) {
+		if (streq(gc->reasons[i], reason)) break;
+	}
+	if (i == gc->n_reasons) {
+		if (i == GENBENCH_MAX_REASONS) {
+			/* Lump the rest in with the last one */
+			--i;
+		} else {
+			gc->reasons[i] = string_make(reason);
+			++gc->n_reasons;
+		}
+	}
+	++gc->reason_counts[i];
+}
+
+static void genbench_handle_room_start(game_event_type et,
+		game_event_data *ed, void *ud)
+{
+	push_stage(GB_STAGE_ROOMS);
+}
+
+static void genbench_handle_stage_start(game_event_type et,
+		game_event_data *ed, void *ud)
+{
+	push_stage(stage_from_name(ed->string));
+}
+
+static void genbench_handle_stage_end(game_event_type et,
+		game_event_data *ed, void *ud)
+{
+	pop_stage();
+}
+
+/**
+ * Mix the base seed with the profile, depth and level number so every level
+ * can be regenerated on its own.
+ */
+static uint32_t level_seed(uint32_t base, int profile, int depth, int n)
+{
+	uint32_t h = base ^ 0x9E3779B9;
+
+	h = (h ^ (uint32_t) profile) * 0x85EBCA6B;
+	h = (h ^ (uint32_t) depth) * 0xC2B2AE35;
+	h = (h ^ (uint32_t) n) * 0x85EBCA6B;
+	return h ^ (h >> 16);
+}
+
+static void run_case(struct genbench_case *gc, uint32_t base, int iprofile,
+		int count)
+{
+	int n;
+
+	(void) force_level_profile(gc->profile);
+	gb.curr = gc;
+	for (n = 0; n < count; ++n) {
+		uint32_t seed = level_seed(base, iprofile, gc->depth, n);
+		clock_t start;
+
+		Rand_quick = false;
+		Rand_state_init(seed);
+		dungeon_change_level(player, gc->depth);
+		gb.tries = 0;
+		gb.depth = 0;
+		start = clock();
+		gb.mark = start;
+		prepare_next_level(player);
+		charge_stage();
+		start = clock() - start;
+
+		++gc->levels;
+		gc->tries += gb.tries;
+		gc->ticks += start;
+		if (start > gc->slowest_ticks || n == 0) {
+			gc->slowest_ticks = start;
+			gc->slowest_seed = seed;
+		}
+		if (gb.tries > gc->most_tries) {
+			gc->most_tries = gb.tries;
+			gc->most_tries_seed = seed;
+		}
+	}
+	gb.curr = NULL;
+	(void) force_level_profile(NULL);
+}
+
+static void put_json_string(FILE *fo, const char *s)
+{
+	fputs("\"", fo);
+	for (; *s; ++s) {
+		if (*s == '"' || *s == '\\') {
+			fprintf(fo, "\\%c", *s);
+		} else if ((unsigned char) *s < 0x20) {
+			fprintf(fo, "\\u%04x", (unsigned) (unsigned char) *s);
+		} else {
+			fputc(*s, fo);
+		}
+	}
+	fputs("\"", fo);
+}
+
+static double seconds(clock_t t)
+{
+	return (double) t / CLOCKS_PER_SEC;
+}
+
+static void dump_results(FILE *fo, const struct genbench_case *cases,
+		int n_cases, uint32_t base, int count)
+{
+	struct rusage ru;
+	long peak = -1;
+	int i, j;
+
+	if (getrusage(RUSAGE_SELF, &ru) == 0) {
+		peak = ru.ru_maxrss;
+	}
+
+	fputs("{\n", fo);
+	fprintf(fo, "  \"seed\": \"%08lx\",\n", (unsigned long) base);
+	fprintf(fo, "  \"levels_per_case\": %d,\n", count);
+	/* Kilobytes on Linux and the BSDs, bytes on macOS */
+	fprintf(fo, "  \"peak_rss\": %ld,\n", peak);
+	fputs("  \"cases\": [", fo);
+	for (i = 0; i < n_cases; ++i) {
+		const struct genbench_case *gc = &cases[i];
+		double secs = seconds(gc->ticks);
+
+		fputs((i) ? ",\n    {\n" : "\n    {\n", fo);
+		fputs("      \"profile\": ", fo);
+		put_json_string(fo, gc->profile);
+		fputs(",\n", fo);
+		fprintf(fo, "      \"depth\": %d,\n", gc->depth);
+		fprintf(fo, "      \"levels\": %d,\n", gc->levels);
+		fprintf(fo, "      \"seconds\": %.6f,\n", secs);
+		fprintf(fo, "      \"levels_per_sec\": %.3f,\n",
+			(secs > 0.0) ? gc->levels / secs : 0.0);
+		fprintf(fo, "      \"tries\": %d,\n", gc->tries);
+		fputs("      \"restarts\": {", fo);
+		for (j = 0; j < gc->n_reasons; ++j) {
+			fputs((j) ? ", " : " ", fo);
+			put_json_string(fo, gc->reasons[j]);
+			fprintf(fo, ": %d", gc->reason_counts[j]);
+		}
+		fputs((gc->n_reasons) ? " },\n" : "},\n", fo);
+		fputs("      \"stage_seconds\": {", fo);
+		for (j = 0; j < GB_STAGE_MAX; ++j) {
+			fprintf(fo, "%s\"%s\": %.6f", (j) ? ", " : " ",
+				stage_names[j], seconds(gc->stage_ticks[j]));
+		}
+		fputs(" },\n", fo);
+		fprintf(fo, "      \"slowest\": { \"seed\": \"%08lx\", "
+			"\"seconds\": %.6f },\n",
+			(unsigned long) gc->slowest_seed,
+			seconds(gc->slowest_ticks));
+		fprintf(fo, "      \"most_tries\": { \"seed\": \"%08lx\", "
+			"\"tries\": %d }\n",
+			(unsigned long) gc->most_tries_seed, gc->most_tries);
+		fputs("    }", fo);
+	}
+	fputs("\n  ]\n}\n", fo);
+}
+
+/**
+ * Split a comma-separated list in place.  Return the number of entries or
+ * -1 if there are more than max.
+ */
+static int split_list(char *s, char **entries, int max)
+{
+	int n = 0;
+
+	while (1) {
+		char *comma = strchr(s, ',');
+
+		if (n >= max) return -1;
+		entries[n++] = s;
+		if (!comma) break;
+		*comma = '\0';
+		s = comma + 1;
+	}
+	return n;
+}
+
+/**
+ * Usage:
+ *
+ * angband -mgenbench -- [-n count] [-d depths] [-p profiles] [-s seed] \
+ *     [-o fname]
+ *
+ *   -n count     Generate count levels for each profile and depth.
+ *   -d depths    Comma-separated list of dungeon depths.
+ *   -p profiles  Comma-separated list of profile names, as in
+ *                dungeon_profile.txt.  By default, all but the town.
+ *   -s seed      Base seed, a hexadecimal value without the leading 0x.
+ *                Each level's seed is derived from it and the profile,
+ *                depth, and level number, and is what's reported for the
+ *                slowest level and the one that needed the most tries.
+ *   -o fname     Write the JSON results to a file named fname.
+ *
+ * Times are processor time.  A level that fails to generate 100 times in a
+ * row still ends the run through cave_generate()'s call to quit().
+ */
+errr init_genbench(int argc, char *argv[]) {
+	static char default_depths[] = "5,15,30,50,75,95";
+	char *depth_names[GENBENCH_MAX_DEPTHS];
+	char *profile_names[GENBENCH_MAX_PROFILES];
+	int depths[GENBENCH_MAX_DEPTHS];
+	int n_depths, n_profiles = 0;
+	int count = GENBENCH_DEFAULT_COUNT;
+	uint32_t base = 0;
+	const char *out_name = NULL;
+	char *depth_list = default_depths;
+	char *profile_list = NULL;
+	struct genbench_case *cases;
+	int n_cases, i, j;
+	int result = 0;
+	FILE *fo;
+
+	/* Skip over argv[0] */
+	for (i = 1; i < argc; ++i) {
+		if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0'
+				|| !strchr("ndpso", argv[i][1])) {
+			printf("init-genbench: bad argument '%s'\n", argv[i]);
+			result = 1;
+			continue;
+		}
+		if (i == argc - 1) {
+			printf("init-genbench: '%s' requires an argument\n",
+				argv[i]);
+			result = 1;
+			continue;
+		}
+		switch (argv[i][1]) {
+		case 'n':
+			count = atoi(argv[i + 1]);
+			if (count < 1) {
+				printf("init-genbench: count must be positive\n");
+				result = 1;
+			}
+			break;
+		case 'd':
+			depth_list = argv[i + 1];
+			break;
+		case 'p':
+			profile_list = argv[i + 1];
+			break;
+		case 's':
+			{
+				char *valend;
+				unsigned long val = strtoul(argv[i + 1],
+					&valend, 16);
+
+				if (argv[i + 1][0] == '\0'
+						|| !contains_only_spaces(valend)
+						|| val > 0xFFFFFFFFul) {
+					printf("init-genbench: bad seed '%s'\n",
+						argv[i + 1]);
+					result = 1;
+				}
+				base = (uint32_t) val;
+			}
+			break;
+		case 'o':
+			out_name = argv[i + 1];
+			break;
+		}
+		++i;
+	}
+
+	n_depths = split_list(depth_list, depth_names, GENBENCH_MAX_DEPTHS);
+	if (n_depths < 0) {
+		printf("init-genbench: too many depths\n");
+		result = 1;
+	}
+
+	if (result != 0) return result;
+
+	init_angband();
+	if (!player_make_simple(NULL, NULL, "Benchmark")) {
+		printf("init-genbench: could not initialize player.\n");
+		cleanup_angband();
+		return 1;
+	}
+
+	for (i = 0; i < n_depths; ++i) {
+		depths[i] = atoi(depth_names[i]);
+		if (depths[i] < 1 || depths[i] >= z_info->max_depth) {
+			printf("init-genbench: bad depth '%s'\n",
+				depth_names[i]);
+			result = 1;
+		}
+	}
+
+	if (profile_list) {
+		n_profiles = split_list(profile_list, profile_names,
+			GENBENCH_MAX_PROFILES);
+		if (n_profiles < 0) {
+			printf("init-genbench: too many profiles\n");
+			result = 1;
+		}
+		for (i = 0; i < n_profiles; ++i) {
+			if (get_level_profile_index_from_name(profile_names[i])
+					< 0) {
+				printf("init-genbench: unknown profile '%s'\n",
+					profile_names[i]);
+				result = 1;
+			}
+		}
+	} else {
+		for (i = 0; i < z_info->profile_max; ++i) {
+			const char *name = get_level_profile_name_from_index(i);
+
+			if (streq(name, "town")) continue;
+			if (n_profiles == GENBENCH_MAX_PROFILES) break;
+			profile_names[n_profiles++] = (char *) name;
+		}
+	}
+	if (result != 0) {
+		cleanup_angband();
+		return result;
+	}
+
+	fo = (out_name) ? fopen(out_name, "w") : stdout;
+	if (!fo) {
+		printf("init-genbench: could not open '%s'\n", out_name);
+		cleanup_angband();
+		return 1;
+	}
+
+	event_add_handler(EVENT_GEN_LEVEL_START, genbench_handle_level_start,
+		NULL);
+	event_add_handler(EVENT_GEN_LEVEL_RESTART, genbench_handle_restart,
+		NULL);
+	event_add_handler(EVENT_GEN_ROOM_START, genbench_handle_room_start,
+		NULL);
+	event_add_handler(EVENT_GEN_ROOM_END, genbench_handle_stage_end, NULL);
+	event_add_handler(EVENT_GEN_STAGE_START, genbench_handle_stage_start,
+		NULL);
+	event_add_handler(EVENT_GEN_STAGE_END, genbench_handle_stage_end,
+		NULL);
+
+	n_cases = n_profiles * n_depths;
+	cases = mem_zalloc(n_cases * sizeof(*cases));
+	for (i = 0; i < n_profiles; ++i) {
+		int iprofile = get_level_profile_index_from_name(
+			profile_names[i]);
+
+		for (j = 0; j < n_depths; ++j) {
+			struct genbench_case *gc = &cases[i * n_depths + j];
+
+			gc->profile = get_level_profile_name_from_index(
+				iprofile);
+			gc->depth = depths[j];
+			run_case(gc, base, iprofile, count);
+		}
+	}
+
+	dump_results(fo, cases, n_cases, base, count);
+	if (fo != stdout) {
+		(void) fclose(fo);
+	}
+
+	for (i = 0; i < n_cases; ++i) {
+		for (j = 0; j < cases[i].n_reasons; ++j) {
+			string_free(cases[i].reasons[j]);
+		}
+	}
+	mem_free(cases);
+
+	event_remove_handler(EVENT_GEN_STAGE_END, genbench_handle_stage_end,
+		NULL);
+	event_remove_handler(EVENT_GEN_STAGE_START,
+		genbench_handle_stage_start, NULL);
+	event_remove_handler(EVENT_GEN_ROOM_END, genbench_handle_stage_end,
+		NULL);
+	event_remove_handler(EVENT_GEN_ROOM_START, genbench_handle_room_start,
+		NULL);
+	event_remove_handler(EVENT_GEN_LEVEL_RESTART, genbench_handle_restart,
+		NULL);
+	event_remove_handler(EVENT_GEN_LEVEL_START,
+		genbench_handle_level_start, NULL);
+
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	exit(0);
+
+	return 0;
+}
+
+#endif /* USE_GENBENCH */
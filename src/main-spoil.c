@@ -293,7 +293,7 @@ errr init_spoil(int argc, char *argv[]) {
 					}
 				} else {
 					seed_randart = specified_seed;
-					do_randart(seed_randart, true);
+					do_randart(seed_randart, true, true);
 				}
 
 				if (result == 0) {
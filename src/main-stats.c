@@ -253,7 +253,7 @@ static void initialize_character(void)
 	seed_randart = randint0(0x10000000);
 
 	if (randarts) {
-		do_randart(seed_randart, false);
+		do_randart(seed_randart, false, false);
 	}
 
 	store_reset();
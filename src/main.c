@@ -91,6 +91,10 @@ static const struct module modules[] =
 	{ "spoil", help_spoil, init_spoil },
 #endif
 
+#ifdef USE_GENBENCH
+	{ "genbench", help_genbench, init_genbench },
+#endif /* USE_GENBENCH */
+
 #ifdef USE_IBM
 	{ "ibm", help_ibm, init_ibm },
 #endif /* USE_IBM */
@@ -41,6 +41,7 @@ extern errr init_sdl2(int argc, char **argv);
 extern errr init_test(int argc, char **argv);
 extern errr init_stats(int argc, char **argv);
 extern errr init_spoil(int argc, char **argv);
+extern errr init_genbench(int argc, char **argv);
 
 
 extern const char help_lfb[];
@@ -61,6 +62,7 @@ extern const char help_sdl2[];
 extern const char help_test[];
 extern const char help_stats[];
 extern const char help_spoil[];
+extern const char help_genbench[];
 
 
 struct module
@@ -34,29 +34,29 @@
 #include "init.h"
 #include "player.h"
 
+/**
+ * One remembered message.  The text buffer belongs to the slot and is kept
+ * when the slot is reused, so that a full log does no allocation.
+ */
 typedef struct _message_t
 {
 	char *str;
-	struct _message_t *newer;
-	struct _message_t *older;
+	size_t size;
 	uint16_t type;
 	uint16_t count;
 } message_t;
 
-typedef struct _msgcolor_t
-{
-	uint16_t type;
-	uint8_t color;
-	struct _msgcolor_t *next;
-} msgcolor_t;
-
+/**
+ * The message log, a ring of `max` slots.  The newest message is in slot
+ * `head`; the one of age n is n slots before it, wrapping around.
+ */
 typedef struct _msgqueue_t
 {
-	message_t *head;
-	message_t *tail;
-	msgcolor_t *colors;
+	message_t *slots;
+	uint32_t head;
 	uint32_t count;
 	uint32_t max;
+	uint8_t colors[MSG_MAX];
 } msgqueue_t;
 
 static msgqueue_t *messages = NULL;
@@ -71,8 +71,14 @@ static msgqueue_t *messages = NULL;
  */
 void messages_init(void)
 {
+	size_t i;
+
 	messages = mem_zalloc(sizeof(msgqueue_t));
-	messages->max = 2048;
+	messages->max = MESSAGE_MAX_DEFAULT;
+	messages->slots = mem_zalloc(messages->max * sizeof(message_t));
+	for (i = 0; i < N_ELEMENTS(messages->colors); i++) {
+		messages->colors[i] = COLOUR_WHITE;
+	}
 }
 
 /**
@@ -80,24 +86,12 @@ void messages_init(void)
  */
 void messages_free(void)
 {
-	msgcolor_t *c = messages->colors;
-	msgcolor_t *nextc;
-	message_t *m = messages->head;
-	message_t *nextm;
+	uint32_t i;
 
-	while (m) {
-		nextm = m->older;
-		mem_free(m->str);
-		mem_free(m);
-		m = nextm;
+	for (i = 0; i < messages->max; i++) {
+		mem_free(messages->slots[i].str);
 	}
-
-	while (c) {
-		nextc = c->next;
-		mem_free(c);
-		c = nextc;
-	}
-
+	mem_free(messages->slots);
 	mem_free(messages);
 }
 
@@ -109,6 +103,48 @@ uint16_t messages_num(void)
 	return messages->count;
 }
 
+/**
+ * Returns the message of age `age`.
+ */
+static message_t *message_get(uint16_t age)
+{
+	if (age >= messages->count) return NULL;
+	return &messages->slots[(messages->head + messages->max - age)
+		% messages->max];
+}
+
+/**
+ * Change the number of messages remembered to `max`, keeping the newest
+ * ones.
+ */
+void messages_set_max(uint16_t max)
+{
+	message_t *slots;
+	uint32_t i, keep;
+
+	if (!max || max == messages->max) return;
+
+	/* Move the kept messages across, oldest first, so the newest ends up
+	 * in the last slot used */
+	slots = mem_zalloc(max * sizeof(message_t));
+	keep = MIN(messages->count, (uint32_t)max);
+	for (i = 0; i < keep; i++) {
+		message_t *m = message_get(keep - 1 - i);
+
+		slots[i] = *m;
+		m->str = NULL;
+	}
+	for (i = 0; i < messages->max; i++) {
+		mem_free(messages->slots[i].str);
+	}
+	mem_free(messages->slots);
+
+	messages->slots = slots;
+	messages->max = max;
+	messages->count = keep;
+	messages->head = keep ? keep - 1 : max - 1;
+}
+
 /**
  * ------------------------------------------------------------------------
  * Functions for individual messages
@@ -123,55 +159,35 @@ uint16_t messages_num(void)
  */
 void message_add(const char *str, uint16_t type)
 {
-	message_t *m;
+	message_t *m = message_get(0);
+	size_t len;
 
-	if (messages->head &&
-	    messages->head->type == type &&
-	    streq(messages->head->str, str) &&
-	    messages->head->count != (uint16_t)-1) {
-		messages->head->count++;
+	if (m && m->type == type && streq(m->str, str) &&
+			m->count != (uint16_t)-1) {
+		m->count++;
 		return;
 	}
 
-	m = mem_zalloc(sizeof(message_t));
-	m->str = string_make(str);
-	m->type = type;
-	m->count = 1;
-	m->older = messages->head;
-
-	if (messages->head)
-		messages->head->newer = m;
-
-	messages->head = m;
-	messages->count++;
-
-	if (!messages->tail)
-		messages->tail = m;
+	/* Take the next slot, overwriting the oldest message if full */
+	messages->head = (messages->head + 1) % messages->max;
+	if (messages->count < messages->max)
+		messages->count++;
+	m = &messages->slots[messages->head];
 
-	if (messages->count > messages->max) {
-		message_t *old_tail = messages->tail;
+	/* Copy before freeing, in case str is the text being overwritten */
+	len = strlen(str) + 1;
+	if (m->size < len) {
+		char *buf = mem_alloc(len);
 
-		messages->tail = old_tail->newer;
-		messages->tail->older = NULL;
-		mem_free(old_tail->str);
-		mem_free(old_tail);
-		messages->count--;
-	}
-}
-
-/**
- * Returns the message of age `age`.
- */
-static message_t *message_get(uint16_t age)
-{
-	message_t *m = messages->head;
-
-	while (m && age) {
-		age--;
-		m = m->older;
+		memcpy(buf, str, len);
+		mem_free(m->str);
+		m->str = buf;
+		m->size = len;
+	} else {
+		memmove(m->str, str, len);
 	}
-
-	return m;
+	m->type = type;
+	m->count = 1;
 }
 
 
@@ -235,32 +251,8 @@ uint8_t message_color(uint16_t age)
  */
 void message_color_define(uint16_t type, uint8_t color)
 {
-	msgcolor_t *mc;
-
-	if (!messages->colors)
-	{
-		messages->colors = mem_zalloc(sizeof(msgcolor_t));
-		messages->colors->type = type;
-		messages->colors->color = color;
-		return;
-	}
-
-	mc = messages->colors;
-	while (1)
-	{
-		if (mc->type == type)
-		{
-			mc->color = color;
-			break;
-		}
-		if (! mc->next) {
-			mc->next = mem_zalloc(sizeof(msgcolor_t));
-			mc->next->type = type;
-			mc->next->color = color;
-			break;
-		}
-		mc = mc->next;
-	}
+	if (type < N_ELEMENTS(messages->colors))
+		messages->colors[type] = color;
 }
 
 /**
@@ -268,19 +260,11 @@ void message_color_define(uint16_t type, uint8_t color)
  */
 uint8_t message_type_color(uint16_t type)
 {
-	msgcolor_t *mc;
 	uint8_t color = COLOUR_WHITE;
 
-	if (messages)
-	{
-		mc = messages->colors;
-
-		while (mc && mc->type != type)
-			mc = mc->next;
-
-		if (mc && (mc->color != COLOUR_DARK))
-			color = mc->color;
-	}
+	if (messages && type < N_ELEMENTS(messages->colors)
+			&& messages->colors[type] != COLOUR_DARK)
+		color = messages->colors[type];
 
 	return color;
 }
@@ -41,10 +41,14 @@ enum {
 };
 
 
+/* Number of messages remembered unless changed by messages_set_max() */
+#define MESSAGE_MAX_DEFAULT 2048
+
 /* Functions */
 void messages_init(void);
 void messages_free(void);
 uint16_t messages_num(void);
+void messages_set_max(uint16_t max);
 void message_add(const char *str, uint16_t type);
 const char *message_str(uint16_t age);
 uint16_t message_count(uint16_t age);
@@ -282,19 +282,27 @@ int choose_attack_spell(bitflag *f, bool innate, bool non_innate)
 {
 	int num = 0;
 	uint8_t spells[RSF_MAX];
+	bitflag allowed[RSF_SIZE], innate_mask[RSF_SIZE];
 
 	int i;
 
 	/* Paranoid initialization */
-	for (i = 0; i < RSF_MAX; i++) {
-		spells[i] = 0;
+	spells[0] = 0;
+
+	/* Filter by innateness as a whole set */
+	rsf_copy(allowed, f);
+	create_mon_spell_mask(innate_mask, RST_INNATE, RST_NONE);
+	if (!innate) {
+		rsf_diff(allowed, innate_mask);
+	}
+	if (!non_innate) {
+		rsf_inter(allowed, innate_mask);
 	}
 
-	/* Extract spells, filtering as necessary */
-	for (i = FLAG_START, num = 0; i < RSF_MAX; i++) {
-		if (!innate && mon_spell_is_innate(i)) continue;
-		if (!non_innate && !mon_spell_is_innate(i)) continue;
-		if (rsf_has(f, i)) spells[num++] = i;
+	/* Extract the spells that are left */
+	for (i = rsf_next(allowed, FLAG_START); i != FLAG_END;
+			i = rsf_next(allowed, i + 1)) {
+		spells[num++] = i;
 	}
 
 	/* Pick at random */
@@ -432,8 +440,8 @@ bool make_ranged_attack(struct monster *mon)
 			ignore_spells(f, RST_BOLT);
 		}
 
-		/* Check for a possible summon */
-		if (!summon_possible(mon->grid)) {
+		/* Check for a possible summon, only if there's one to cast */
+		if (test_spells(f, RST_SUMMON) && !summon_possible(mon->grid)) {
 			ignore_spells(f, RST_SUMMON);
 		}
 	}
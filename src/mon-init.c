@@ -1758,9 +1758,10 @@ static errr finish_parse_monster(struct parser *p) {
 	size_t i;
 	int ridx;
 
-	/* Scan the list for the max id and max blows */
+	/* Scan the list for the max id, max blows and max light */
 	z_info->r_max = 0;
 	z_info->mon_blows_max = 0;
+	z_info->mon_light_max = 0;
 	r = parser_priv(p);
 	while (r) {
 		int max_blows = 0;
@@ -1772,6 +1773,8 @@ static errr finish_parse_monster(struct parser *p) {
 		}
 		if (max_blows > z_info->mon_blows_max)
 			z_info->mon_blows_max = max_blows;
+		if (ABS(r->light) > z_info->mon_light_max)
+			z_info->mon_light_max = ABS(r->light);
 		r = r->next;
 	}
 
@@ -18,10 +18,10 @@
  */
 
 #include "game-world.h"
+#include "init.h"
 #include "mon-desc.h"
 #include "mon-list.h"
 #include "mon-predicate.h"
-#include "project.h"
 
 /**
  * Allocate a new monster list based on the size of the current cave's monster
@@ -44,6 +44,11 @@ monster_list_t *monster_list_new(void)
 
 	list->entries_size = size;
 
+	/* Map from race index to (entry index + 1), so that collection doesn't
+	 * need to search the entries for a matching race. */
+	list->race_entry = mem_zalloc(z_info->r_max * sizeof(uint16_t));
+	list->race_entry_size = z_info->r_max;
+
 	return list;
 }
 
@@ -60,6 +65,7 @@ void monster_list_free(monster_list_t *list)
 		list->entries = NULL;
 	}
 
+	mem_free(list->race_entry);
 	mem_free(list);
 	list = NULL;
 }
@@ -97,6 +103,43 @@ monster_list_t *monster_list_shared_instance(void)
 	return monster_list_subwindow;
 }
 
+/**
+ * Change counter for the monster list.  This is bumped whenever something the
+ * list displays may have changed: a monster becoming visible or invisible,
+ * moving, waking or changing shape, a monster being deleted, or the player
+ * moving.  A list remembers the value it was collected at, so an unchanged
+ * list doesn't need to be rebuilt on every redraw.
+ */
+static uint32_t monster_list_change_stamp = 1;
+
+/**
+ * Note that the visible monsters may have changed since the last collection.
+ */
+void monster_list_note_change(void)
+{
+	monster_list_change_stamp++;
+
+	/* Zero is reserved for lists which have never been collected */
+	if (monster_list_change_stamp == 0)
+		monster_list_change_stamp = 1;
+}
+
+/**
+ * Return true if the list needs to be collected again, either because it was
+ * never collected, an update has been forced, or the visible monsters may have
+ * changed since it was.
+ */
+bool monster_list_needs_update(const monster_list_t *list)
+{
+	if (list == NULL || list->entries == NULL)
+		return false;
+
+	if (list->creation_turn <= 0 || list->stamp != monster_list_change_stamp)
+		return true;
+
+	return (int)list->entries_size < cave_monster_max(cave);
+}
+
 /**
  * Return true if there is nothing preventing the list from being updated. This
  * should be for structural sanity checks and not gameplay checks.
@@ -115,6 +158,8 @@ static bool monster_list_can_update(const monster_list_t *list)
  */
 void monster_list_reset(monster_list_t *list)
 {
+	int i;
+
 	if (list == NULL || list->entries == NULL)
 		return;
 
@@ -124,11 +169,20 @@ void monster_list_reset(monster_list_t *list)
 		list->entries_size = cave_monster_max(cave);
 	}
 
+	/* Only the races in the list have been entered in the race map. */
+	for (i = 0; i < (int)list->distinct_entries; i++) {
+		struct monster_race *race = list->entries[i].race;
+
+		if (race != NULL && race->ridx < list->race_entry_size)
+			list->race_entry[race->ridx] = 0;
+	}
+
 	memset(list->entries, 0, list->entries_size * sizeof(monster_list_entry_t));
 	memset(list->total_entries, 0, MONSTER_LIST_SECTION_MAX * sizeof(uint16_t));
 	memset(list->total_monsters, 0, MONSTER_LIST_SECTION_MAX * sizeof(uint16_t));
 	list->distinct_entries = 0;
 	list->creation_turn = 0;
+	list->stamp = 0;
 	list->sorted = false;
 }
 
@@ -149,44 +203,41 @@ void monster_list_collect(monster_list_t *list)
 	for (i = 1; i < cave_monster_max(cave); i++) {
 		struct monster *mon = cave_monster(cave, i);
 		monster_list_entry_t *entry = NULL;
-		int j, field;
+		int field;
 		bool los = false;
 
 		/* Only consider visible, known monsters */
 		if (!monster_is_visible(mon) ||	monster_is_camouflaged(mon))
 			continue;
 
-		/* Find or add a list entry. */
-		for (j = 0; j < (int)list->entries_size; j++) {
-			if (list->entries[j].race == NULL) {
-				/* We found an empty slot, so add this race here. */
-				entry = &list->entries[j];
-				memset(entry, 0, sizeof(monster_list_entry_t));
-				entry->race = mon->race;
-				break;
-			}
-			else if (list->entries[j].race == mon->race) {
-				/* We found a matching race and we'll use that. */
-				entry = &list->entries[j];
-				break;
-			}
-		}
-
-		if (entry == NULL)
+		/* Find or add the list entry for this race. */
+		if (mon->race->ridx >= list->race_entry_size)
 			continue;
 
+		if (list->race_entry[mon->race->ridx]) {
+			entry = &list->entries[list->race_entry[mon->race->ridx] - 1];
+		} else {
+			if (list->distinct_entries >= list->entries_size)
+				continue;
+
+			entry = &list->entries[list->distinct_entries];
+			memset(entry, 0, sizeof(monster_list_entry_t));
+			entry->race = mon->race;
+			list->distinct_entries++;
+			list->race_entry[mon->race->ridx] = list->distinct_entries;
+		}
+
 		/* Always collect the latest monster attribute so that flicker
 		 * animation works. If this is 0, it needs to be replaced by 
 		 * the standard glyph in the UI */
 		entry->attr = mon->attr;
+		entry->midx = mon->midx;
 
 		/*
-		 * Check for LOS
-		 * Hack - we should use (mon->mflag & (MFLAG_VIEW)) here,
-		 * but this does not catch monsters detected by ESP which are
-		 * targetable, so we cheat and use projectable() instead
+		 * Check for LOS, using the view already computed by update_view();
+		 * this also catches monsters detected by ESP which are targetable.
 		 */
-		los = projectable(cave, player->grid, mon->grid, PROJECT_NONE);
+		los = square_isview(cave, mon->grid);
 		field = (los) ? MONSTER_LIST_SECTION_LOS : MONSTER_LIST_SECTION_ESP;
 		entry->count[field]++;
 
@@ -200,10 +251,7 @@ void monster_list_collect(monster_list_t *list)
 	}
 
 	/* Collect totals for easier calculations of the list. */
-	for (i = 0; i < (int)list->entries_size; i++) {
-		if (list->entries[i].race == NULL)
-			continue;
-
+	for (i = 0; i < (int)list->distinct_entries; i++) {
 		if (list->entries[i].count[MONSTER_LIST_SECTION_LOS] > 0)
 			list->total_entries[MONSTER_LIST_SECTION_LOS]++;
 
@@ -214,13 +262,38 @@ void monster_list_collect(monster_list_t *list)
 			list->entries[i].count[MONSTER_LIST_SECTION_LOS];
 		list->total_monsters[MONSTER_LIST_SECTION_ESP] +=
 			list->entries[i].count[MONSTER_LIST_SECTION_ESP];
-		list->distinct_entries++;
 	}
 
-	list->creation_turn = turn;
+	/* Keep the turn positive so the list doesn't look uncollected */
+	list->creation_turn = MAX(turn, 1);
+	list->stamp = monster_list_change_stamp;
 	list->sorted = false;
 }
 
+/**
+ * Pick up the latest attribute of each entry's monster without recollecting
+ * the list, so that flicker animation works on an otherwise unchanged list.
+ */
+void monster_list_refresh_attrs(monster_list_t *list)
+{
+	int i;
+
+	if (list == NULL || list->entries == NULL)
+		return;
+
+	for (i = 0; i < (int)list->distinct_entries; i++) {
+		monster_list_entry_t *entry = &list->entries[i];
+		struct monster *mon;
+
+		if (entry->midx <= 0 || entry->midx >= cave_monster_max(cave))
+			continue;
+
+		mon = cave_monster(cave, entry->midx);
+		if (mon->race == entry->race)
+			entry->attr = mon->attr;
+	}
+}
+
 /**
  * Standard comparison function for the monster list: sort by depth and then
  * power.
@@ -34,13 +34,17 @@ typedef struct monster_list_entry_s {
 	uint16_t asleep[MONSTER_LIST_SECTION_MAX];
 	int16_t dx[MONSTER_LIST_SECTION_MAX], dy[MONSTER_LIST_SECTION_MAX];
 	uint8_t attr;
+	int16_t midx;
 } monster_list_entry_t;
 
 typedef struct monster_list_s {
 	monster_list_entry_t *entries;
 	size_t entries_size;
+	uint16_t *race_entry;
+	size_t race_entry_size;
 	uint16_t distinct_entries;
 	int32_t creation_turn;
+	uint32_t stamp;
 	bool sorted;
 	uint16_t total_entries[MONSTER_LIST_SECTION_MAX];
 	uint16_t total_monsters[MONSTER_LIST_SECTION_MAX];
@@ -51,6 +55,9 @@ void monster_list_free(monster_list_t *list);
 void monster_list_init(void);
 void monster_list_finalize(void);
 monster_list_t *monster_list_shared_instance(void);
+void monster_list_note_change(void);
+bool monster_list_needs_update(const monster_list_t *list);
+void monster_list_refresh_attrs(monster_list_t *list);
 void monster_list_reset(monster_list_t *list);
 void monster_list_collect(monster_list_t *list);
 int monster_list_standard_compare(const void *a, const void *b);
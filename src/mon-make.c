@@ -21,6 +21,7 @@
 #include "game-world.h"
 #include "init.h"
 #include "mon-group.h"
+#include "mon-list.h"
 #include "mon-lore.h"
 #include "mon-make.h"
 #include "mon-predicate.h"
@@ -392,6 +393,9 @@ void delete_monster_idx(struct chunk *c, int m_idx)
 	/* Count monsters */
 	c->mon_cnt--;
 
+	if (c == cave)
+		monster_list_note_change();
+
 	/* Visual update */
 	square_light_spot(c, grid);
 }
@@ -462,9 +466,28 @@ void monster_index_move(struct chunk *c, int i1, int i2)
 
 	/* Wipe hole */
 	memset(cave_monster(c, i1), 0, sizeof(struct monster));
+
+	if (c == cave)
+		monster_list_note_change();
 }
 
 
+/**
+ * A monster considered for deletion by compact_monsters()
+ */
+struct compact_victim {
+	int midx;
+	uint32_t rank;
+};
+
+static int cmp_compact_victim(const void *a, const void *b)
+{
+	const struct compact_victim *va = a, *vb = b;
+
+	if (va->rank < vb->rank) return -1;
+	return (va->rank > vb->rank) ? 1 : 0;
+}
+
 /**
  * Compacts and reorders the monster list.
  *
@@ -474,16 +497,15 @@ void monster_index_move(struct chunk *c, int i1, int i2)
  * order, eliminating any "holes" left by dead monsters. If `num_to_compact` is
  * positive, then we delete at least that many monsters and then reorder.
  * We try not to delete monsters that are high level or close to the player.
- * Each time we make a full pass through the monster list, if we haven't
- * deleted enough monsters, we relax our bounds a little to accept
- * monsters of a slightly higher level, and monsters slightly closer to
- * the player.
+ * Every monster is ranked once:  ordinary monsters go before uniques, which
+ * go before quest monsters, and within those low level monsters far from the
+ * player go first, ties being broken at random.  The lowest ranked monsters
+ * are then deleted together.
  */
 void compact_monsters(struct chunk *c, int num_to_compact)
 {
-	int m_idx, num_compacted, iter;
-
-	int max_lev, min_dis, chance;
+	int m_idx, num_compacted, num = 0;
+	struct compact_victim *victims;
 
 
 	/* Message (only if compacting) */
@@ -491,47 +513,43 @@ void compact_monsters(struct chunk *c, int num_to_compact)
 		msg("Compacting monsters...");
 
 
-	/* Compact at least 'num_to_compact' objects */
-	for (num_compacted = 0, iter = 1; num_compacted < num_to_compact; iter++) {
-		/* Get more vicious each iteration */
-		max_lev = 5 * iter;
-
-		/* Get closer each iteration */
-		min_dis = 5 * (20 - iter);
-
-		/* Check all the monsters */
-		for (m_idx = 1; m_idx < cave_monster_max(c); m_idx++) {
-			struct monster *mon = cave_monster(c, m_idx);
-
-			/* Skip "dead" monsters */
-			if (!mon->race) continue;
-
-			/* High level monsters start out "immune" */
-			if (mon->race->level > max_lev) continue;
-
-			/* Ignore nearby monsters */
-			if ((min_dis > 0) && (mon->cdis < min_dis)) continue;
-
-			/* Saving throw chance */
-			chance = 90;
+	/* Rank all the monsters */
+	victims = num_to_compact ?
+		mem_alloc(cave_monster_max(c) * sizeof(*victims)) : NULL;
+	for (m_idx = 1; num_to_compact && m_idx < cave_monster_max(c); m_idx++) {
+		struct monster *mon = cave_monster(c, m_idx);
+		uint32_t kind = 0, stage;
 
-			/* Only compact "Quest" Monsters in emergencies */
-			if (rf_has(mon->race->flags, RF_QUESTOR) && (iter < 1000))
-				chance = 100;
+		/* Skip "dead" monsters */
+		if (!mon->race) continue;
 
+		/* Only compact "Quest" Monsters in emergencies */
+		if (rf_has(mon->race->flags, RF_QUESTOR)) {
+			kind = 2;
+		} else if (monster_is_unique(mon)) {
 			/* Try not to compact Unique Monsters */
-			if (monster_is_unique(mon)) chance = 99;
+			kind = 1;
+		}
 
-			/* All monsters get a saving throw */
-			if (randint0(100) < chance) continue;
+		/* Higher level and closer monsters wait longer */
+		stage = MAX((mon->race->level + 4) / 5, 20 - mon->cdis / 5);
+		stage = MIN(MAX(stage, 1), 255);
 
-			/* Delete the monster */
-			delete_monster(c, mon->grid);
+		victims[num].midx = m_idx;
+		victims[num].rank = (kind << 24) | (stage << 16) |
+			(uint32_t) randint0(0x10000);
+		num++;
+	}
 
-			/* Count the monster */
-			num_compacted++;
-		}
+	/* Delete the lowest ranked monsters */
+	if (num > num_to_compact) {
+		sort(victims, num, sizeof(*victims), cmp_compact_victim);
+	}
+	for (num_compacted = 0; num_compacted < MIN(num, num_to_compact);
+			num_compacted++) {
+		delete_monster_idx(c, victims[num_compacted].midx);
 	}
+	mem_free(victims);
 
 
 	/* Excise dead monsters (backwards!) */
@@ -820,8 +838,7 @@ static bool mon_create_drop(struct chunk *c, struct monster *mon,
 				any = true;
 			} else {
 				mark_artifact_created(obj->artifact, false);
-				object_wipe(obj);
-				mem_free(obj);
+				object_free(obj);
 			}
 		}
 	}
@@ -834,7 +851,7 @@ static bool mon_create_drop(struct chunk *c, struct monster *mon,
 		/* Specified by tval or by kind */
 		if (drop->kind) {
 			/* Allocate by hand, prep, apply magic */
-			obj = mem_zalloc(sizeof(*obj));
+			obj = object_new();
 			object_prep(obj, drop->kind, level, RANDOMISE);
 			apply_magic(obj, level, true, good, great, extra_roll);
 		} else {
@@ -858,8 +875,7 @@ static bool mon_create_drop(struct chunk *c, struct monster *mon,
 		if (monster_carry(c, mon, obj)) {
 			any = true;
 		} else {
-			object_wipe(obj);
-			mem_free(obj);
+			object_free(obj);
 		}
 	}
 
@@ -884,8 +900,7 @@ static bool mon_create_drop(struct chunk *c, struct monster *mon,
 			if (obj->artifact) {
 				mark_artifact_created(obj->artifact, false);
 			}
-			object_wipe(obj);
-			mem_free(obj);
+			object_free(obj);
 		}
 	}
 
@@ -1180,6 +1195,7 @@ static bool place_new_monster_one(struct chunk *c, struct loc grid,
 		mflag_on(mon->mflag, MFLAG_CAMOUFLAGE);
 	else
 		mflag_off(mon->mflag, MFLAG_CAMOUFLAGE);
+	monster_list_note_change();
 
 	/* Set the color if necessary */
 	if (rf_has(race->flags, RF_ATTR_RAND))
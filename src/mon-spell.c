@@ -403,6 +403,41 @@ static const struct mon_spell_info {
     #undef RSF
 };
 
+/**
+ * The spells of each single type, indexed by the number of the type bit,
+ * so selection can work on whole flag sets rather than spell by spell
+ */
+static bitflag spell_type_masks[RST_BITS][RSF_SIZE];
+static bool spell_type_masks_ready = false;
+
+/**
+ * Fill f with all the spells having any of the given types
+ */
+static void spell_types_mask(bitflag *f, int types)
+{
+	int bit;
+
+	if (!spell_type_masks_ready) {
+		const struct mon_spell_info *info;
+
+		for (info = mon_spell_types; info->index < RSF_MAX; info++) {
+			for (bit = 0; bit < RST_BITS; bit++) {
+				if (info->type & (1 << bit)) {
+					rsf_on(spell_type_masks[bit], info->index);
+				}
+			}
+		}
+		spell_type_masks_ready = true;
+	}
+
+	rsf_wipe(f);
+	for (bit = 0; bit < RST_BITS; bit++) {
+		if (types & (1 << bit)) {
+			rsf_union(f, spell_type_masks[bit]);
+		}
+	}
+}
+
 
 static bool mon_spell_is_valid(int index)
 {
@@ -433,13 +468,10 @@ bool mon_spell_is_innate(int index)
  */
 bool test_spells(bitflag *f, int types)
 {
-	const struct mon_spell_info *info;
-
-	for (info = mon_spell_types; info->index < RSF_MAX; info++)
-		if (rsf_has(f, info->index) && (info->type & types))
-			return true;
+	bitflag mask[RSF_SIZE];
 
-	return false;
+	spell_types_mask(mask, types);
+	return rsf_is_inter(f, mask);
 }
 
 /**
@@ -450,11 +482,10 @@ bool test_spells(bitflag *f, int types)
  */
 void ignore_spells(bitflag *f, int types)
 {
-	const struct mon_spell_info *info;
+	bitflag mask[RSF_SIZE];
 
-	for (info = mon_spell_types; info->index < RSF_MAX; info++)
-		if (rsf_has(f, info->index) && (info->type & types))
-			rsf_off(f, info->index);
+	spell_types_mask(mask, types);
+	rsf_diff(f, mask);
 }
 
 /**
@@ -470,16 +501,18 @@ void ignore_spells(bitflag *f, int types)
 void unset_spells(bitflag *spells, bitflag *flags, bitflag *pflags,
 				  struct element_info *el, const struct monster *mon)
 {
-	const struct mon_spell_info *info;
 	bool smart = monster_is_smart(mon);
+	int i;
 
-	for (info = mon_spell_types; info->index < RSF_MAX; info++) {
-		const struct monster_spell *spell = monster_spell_by_index(info->index);
+	/* Only visit the spells actually present, in index order */
+	for (i = rsf_next(spells, FLAG_START); i != FLAG_END;
+			i = rsf_next(spells, i + 1)) {
+		const struct mon_spell_info *info = &mon_spell_types[i];
+		const struct monster_spell *spell = monster_spell_by_index(i);
 		const struct effect *effect;
 
 		/* Ignore missing spells */
 		if (!spell) continue;
-		if (!rsf_has(spells, info->index)) continue;
 
 		/* Get the effect */
 		effect = spell->effect;
@@ -656,25 +689,20 @@ static int mon_spell_dam(int index, int hp, const struct monster_race *race,
  */
 void create_mon_spell_mask(bitflag *f, ...)
 {
-	const struct mon_spell_info *rs;
-	int i;
+	int i, types = RST_NONE;
 	va_list args;
 
-	rsf_wipe(f);
-
 	va_start(args, f);
 
 	/* Process each type in the va_args */
     for (i = va_arg(args, int); i != RST_NONE; i = va_arg(args, int)) {
-		for (rs = mon_spell_types; rs->index < RSF_MAX; rs++) {
-			if (rs->type & i) {
-				rsf_on(f, rs->index);
-			}
-		}
+		types |= i;
 	}
 
 	va_end(args);
 
+	spell_types_mask(f, types);
+
 	return;
 }
 
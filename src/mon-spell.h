@@ -46,6 +46,9 @@ enum mon_spell_type {
 
 #define RST_DAMAGE (RST_BOLT | RST_BALL | RST_BREATH | RST_DIRECT)
 
+/* Number of distinct spell type bits above */
+#define RST_BITS 13
+
 /** Macros **/
 #define rsf_has(f, flag)       flag_has_dbg(f, RSF_SIZE, flag, #f, #flag)
 #define rsf_next(f, flag)      flag_next(f, RSF_SIZE, flag)
@@ -18,6 +18,7 @@
 
 #include "angband.h"
 #include "mon-desc.h"
+#include "mon-list.h"
 #include "mon-lore.h"
 #include "mon-msg.h"
 #include "mon-predicate.h"
@@ -221,6 +222,8 @@ static bool mon_set_timed(struct monster *mon,
 			player->upkeep->redraw |= (PR_HEALTH);
 
 		player->upkeep->redraw |= (PR_MONLIST);
+		if (effect_type == MON_TMD_SLEEP)
+			monster_list_note_change();
 	}
 
 	return !resisted;
@@ -308,6 +308,9 @@ void update_mon(struct monster *mon, struct chunk *c, bool full)
 	/* ESP permitted */
 	bool telepathy_ok = player_of_has(player, OF_TELEPATHY);
 
+	/* Previous visibility, to tell the monster list about changes */
+	bool was_visible, was_in_view, was_camouflaged;
+
 	assert(mon != NULL);
 
 	/* Return if this is not the current level */
@@ -315,6 +318,10 @@ void update_mon(struct monster *mon, struct chunk *c, bool full)
 		return;
 	}
 
+	was_visible = monster_is_visible(mon);
+	was_in_view = monster_is_in_view(mon);
+	was_camouflaged = monster_is_camouflaged(mon);
+
 	lore = get_lore(mon->race);
 	
 	/* Compute distance, or just use the current one */
@@ -414,6 +421,10 @@ void update_mon(struct monster *mon, struct chunk *c, bool full)
 
 			/* Draw the monster */
 			square_light_spot(c, mon->grid);
+			if (c == cave) {
+				event_signal_monster(EVENT_MONSTER_SEEN, mon->midx,
+					mon->grid, mon->grid);
+			}
 
 			/* Update health bar as needed */
 			if (player->upkeep->health_who == mon)
@@ -435,6 +446,10 @@ void update_mon(struct monster *mon, struct chunk *c, bool full)
 
 			/* Erase the monster */
 			square_light_spot(c, mon->grid);
+			if (c == cave) {
+				event_signal_monster(EVENT_MONSTER_SEEN, mon->midx,
+					mon->grid, mon->grid);
+			}
 
 			/* Update health bar as needed */
 			if (player->upkeep->health_who == mon)
@@ -474,6 +489,16 @@ void update_mon(struct monster *mon, struct chunk *c, bool full)
 			player->upkeep->redraw |= PR_MONLIST;
 		}
 	}
+
+	/*
+	 * The monster list only needs rebuilding when visibility changes,
+	 * which includes a disguise being dropped
+	 */
+	if (was_visible != monster_is_visible(mon)
+			|| was_in_view != monster_is_in_view(mon)
+			|| was_camouflaged != monster_is_camouflaged(mon)) {
+		monster_list_note_change();
+	}
 }
 
 /**
@@ -672,6 +697,16 @@ void monster_swap(struct loc grid1, struct loc grid2)
 		cmd_disable_repeat_floor_item();
 	}
 
+	/* Positions in the monster list have changed */
+	if (m1 || m2)
+		monster_list_note_change();
+
+	/* Tell anyone following the monsters */
+	if (m1 > 0)
+		event_signal_monster(EVENT_MONSTER_MOVED, m1, grid2, grid1);
+	if (m2 > 0)
+		event_signal_monster(EVENT_MONSTER_MOVED, m2, grid1, grid2);
+
 	/* Redraw */
 	square_light_spot(cave, grid1);
 	square_light_spot(cave, grid2);
@@ -716,6 +751,10 @@ void become_aware(struct chunk *c, struct monster *mon)
 	if (mflag_has(mon->mflag, MFLAG_CAMOUFLAGE)) {
 		mflag_off(mon->mflag, MFLAG_CAMOUFLAGE);
 
+		/* The monster list can show it now */
+		monster_list_note_change();
+		player->upkeep->redraw |= PR_MONLIST;
+
 		/* Learn about mimicry */
 		if (rf_has(mon->race->flags, RF_UNAWARE))
 			rf_on(lore->flags, RF_UNAWARE);
@@ -1665,6 +1704,7 @@ bool monster_change_shape(struct monster *mon)
 		if (!mon->original_race) mon->original_race = mon->race;
 		mon->race = race;
 		mon->mspeed += mon->race->speed - mon->original_race->speed;
+		monster_list_note_change();
 	}
 
 	/* Emergency teleport if needed */
@@ -1696,6 +1736,7 @@ bool monster_revert_shape(struct monster *mon)
 		mon->mspeed += mon->original_race->speed - mon->race->speed;
 		mon->race = mon->original_race;
 		mon->original_race = NULL;
+		monster_list_note_change();
 
 		/* Emergency teleport if needed */
 		if (!monster_passes_walls(mon) &&
@@ -17,6 +17,7 @@
  */
 
 #include "angband.h"
+#include "init.h"
 #include "obj-chest.h"
 #include "obj-desc.h"
 #include "obj-gear.h"
@@ -578,33 +579,155 @@ static size_t obj_desc_aware(const struct object *obj, char *buf, size_t max,
 
 
 /**
- * Describes item `obj` into buffer `buf` of size `max`.
- *
- * \param buf is the buffer for the description.  Must have space for at least
- * max bytes.
- * \param max is the size of the buffer, in bytes.
- * \param obj is the object to describe.
- * \param mode must be a bitwise-or of zero or one more of the following:
- * ODESC_PREFIX prepends a 'the', 'a' or number
- * ODESC_BASE results in a base description.
- * ODESC_COMBAT will add to-hit, to-dam and AC info.
- * ODESC_EXTRA will add pval/charge/inscription/ignore info.
- * ODESC_PLURAL will pluralise regardless of the number in the stack.
- * ODESC_STORE turns off ignore markers, for in-store display.
- * ODESC_SPOIL treats the object as fully identified.
- * ODESC_CAPITAL capitalises the object name.
- * ODESC_TERSE causes a terse name to be used.
- * ODESC_NOEGO omits ego names.
- * ODESC_ALTNUM causes the high 16 bits of mode to be used as the number
- * of objects instead of using obj->number.  Note that using ODESC_ALTNUM
- * is not fully compatible with ODESC_EXTRA:  the display of number of rods
- * charging does not account for the alternate number.
- * \param p is the player whose knowledge is factored into the description.
- * If p is NULL, the description is for an omniscient observer.
- *
- * \returns The number of bytes used of the buffer.
+ * ------------------------------------------------------------------------
+ * Description cache
+ * ------------------------------------------------------------------------ */
+/**
+ * Lists of objects are redrawn far more often than the objects in them
+ * change, so recent descriptions are kept.  Rather than chase every change to
+ * an object, each entry is keyed by a hash of everything the description
+ * depends on: the object and what is known of it, the flavour knowledge and
+ * ignore status for its kind, the player's rune knowledge and options, and
+ * the mode.  Anything else, like the artifact names chosen for a new game,
+ * is covered by the epoch, which object_desc_forget() moves on.  An entry is
+ * also tied to the object, mode and player it was made for, so that two
+ * objects whose keys collide can never be given each other's names.
  */
-size_t object_desc(char *buf, size_t max, const struct object *obj,
+#define DESC_CACHE_SIZE 256
+#define DESC_CACHE_LEN 120
+
+static struct desc_cache_entry {
+	uint64_t key;
+	uint32_t epoch;
+	const struct object *obj;
+	const struct player *p;
+	uint32_t mode;
+	size_t len;
+	char desc[DESC_CACHE_LEN];
+} desc_cache[DESC_CACHE_SIZE];
+
+static uint32_t desc_epoch = 1;
+
+/**
+ * Mix len bytes of data into the hash h, a word at a time where possible
+ */
+static uint64_t desc_hash(uint64_t h, const void *data, size_t len)
+{
+	const unsigned char *bytes = data;
+	uint64_t word;
+
+	while (len >= sizeof(word)) {
+		memcpy(&word, bytes, sizeof(word));
+		h = (h ^ word) * 0x100000001b3ULL;
+		h ^= h >> 29;
+		bytes += sizeof(word);
+		len -= sizeof(word);
+	}
+	while (len--) {
+		h = (h ^ *bytes++) * 0x100000001b3ULL;
+	}
+	return h;
+}
+
+#define DESC_HASH(h, field) desc_hash((h), &(field), sizeof(field))
+
+static uint64_t desc_hash_object(uint64_t h, const struct object *obj)
+{
+	int i;
+
+	h = DESC_HASH(h, obj->kind);
+	h = DESC_HASH(h, obj->ego);
+	h = DESC_HASH(h, obj->artifact);
+	h = DESC_HASH(h, obj->tval);
+	h = DESC_HASH(h, obj->sval);
+	h = DESC_HASH(h, obj->pval);
+	h = DESC_HASH(h, obj->dd);
+	h = DESC_HASH(h, obj->ds);
+	h = DESC_HASH(h, obj->ac);
+	h = DESC_HASH(h, obj->to_a);
+	h = DESC_HASH(h, obj->to_h);
+	h = DESC_HASH(h, obj->to_d);
+	h = DESC_HASH(h, obj->flags);
+	h = DESC_HASH(h, obj->modifiers);
+	h = DESC_HASH(h, obj->el_info);
+	h = DESC_HASH(h, obj->effect);
+	h = DESC_HASH(h, obj->activation);
+	h = DESC_HASH(h, obj->time);
+	h = DESC_HASH(h, obj->timeout);
+	h = DESC_HASH(h, obj->number);
+	h = DESC_HASH(h, obj->notice);
+	h = DESC_HASH(h, obj->note);
+
+	/* Array contents, with a marker for whether there is an array */
+	h = DESC_HASH(h, obj->brands);
+	if (obj->brands) {
+		h = desc_hash(h, obj->brands,
+			z_info->brand_max * sizeof(*obj->brands));
+	}
+	h = DESC_HASH(h, obj->slays);
+	if (obj->slays) {
+		h = desc_hash(h, obj->slays,
+			z_info->slay_max * sizeof(*obj->slays));
+	}
+	h = DESC_HASH(h, obj->curses);
+	if (obj->curses) {
+		for (i = 0; i < z_info->curse_max; i++) {
+			h = DESC_HASH(h, obj->curses[i].power);
+		}
+	}
+
+	return h;
+}
+
+/**
+ * Get the cache key for describing obj with the given mode for p
+ */
+static uint64_t desc_cache_key(const struct object *obj, uint32_t mode,
+		const struct player *p)
+{
+	uint64_t h = 0xcbf29ce484222325ULL;
+	bool flag;
+
+	h = desc_hash_object(h, obj);
+	h = desc_hash_object(h, obj->known);
+	h = DESC_HASH(h, obj->kind->aware);
+	h = DESC_HASH(h, obj->kind->tried);
+	h = DESC_HASH(h, obj->kind->flavor);
+	h = DESC_HASH(h, mode);
+	h = DESC_HASH(h, p);
+	if (p) {
+		h = DESC_HASH(h, p->obj_k->dd);
+		h = DESC_HASH(h, p->obj_k->ds);
+		h = DESC_HASH(h, p->obj_k->ac);
+		h = DESC_HASH(h, p->obj_k->to_a);
+		h = DESC_HASH(h, p->obj_k->to_h);
+		h = DESC_HASH(h, p->obj_k->to_d);
+		flag = OPT(p, show_flavors);
+		h = DESC_HASH(h, flag);
+
+		/* Only worked out when the description would show it */
+		if ((mode & ODESC_EXTRA) && !(mode & ODESC_STORE)) {
+			flag = ignore_item_ok(p, obj);
+			h = DESC_HASH(h, flag);
+		}
+	}
+
+	return h;
+}
+
+/**
+ * Forget all the cached object descriptions, for when something other than
+ * the objects and the player's knowledge changes what they would be
+ */
+void object_desc_forget(void)
+{
+	desc_epoch++;
+}
+
+/**
+ * Describe an object without looking in the cache; see object_desc()
+ */
+static size_t object_desc_aux(char *buf, size_t max, const struct object *obj,
 		uint32_t mode, const struct player *p)
 {
 	bool prefix = mode & ODESC_PREFIX ? true : false;
@@ -665,3 +788,78 @@ size_t object_desc(char *buf, size_t max, const struct object *obj,
 
 	return end;
 }
+
+
+/**
+ * Describes item `obj` into buffer `buf` of size `max`.
+ *
+ * \param buf is the buffer for the description.  Must have space for at least
+ * max bytes.
+ * \param max is the size of the buffer, in bytes.
+ * \param obj is the object to describe.
+ * \param mode must be a bitwise-or of zero or one more of the following:
+ * ODESC_PREFIX prepends a 'the', 'a' or number
+ * ODESC_BASE results in a base description.
+ * ODESC_COMBAT will add to-hit, to-dam and AC info.
+ * ODESC_EXTRA will add pval/charge/inscription/ignore info.
+ * ODESC_PLURAL will pluralise regardless of the number in the stack.
+ * ODESC_STORE turns off ignore markers, for in-store display.
+ * ODESC_SPOIL treats the object as fully identified.
+ * ODESC_CAPITAL capitalises the object name.
+ * ODESC_TERSE causes a terse name to be used.
+ * ODESC_NOEGO omits ego names.
+ * ODESC_ALTNUM causes the high 16 bits of mode to be used as the number
+ * of objects instead of using obj->number.  Note that using ODESC_ALTNUM
+ * is not fully compatible with ODESC_EXTRA:  the display of number of rods
+ * charging does not account for the alternate number.
+ * \param p is the player whose knowledge is factored into the description.
+ * If p is NULL, the description is for an omniscient observer.
+ *
+ * \returns The number of bytes used of the buffer.
+ *
+ * Recent descriptions are cached; see desc_cache_key() for what they depend
+ * on.
+ */
+size_t object_desc(char *buf, size_t max, const struct object *obj,
+		uint32_t mode, const struct player *p)
+{
+	struct desc_cache_entry *entry;
+	uint64_t key;
+	size_t end;
+
+	/* The simple cases aren't worth keeping */
+	if (!obj || !obj->known || obj->kind != obj->known->kind ||
+			tval_is_money(obj)) {
+		return object_desc_aux(buf, max, obj, mode, p);
+	}
+
+	key = desc_cache_key(obj, mode, p);
+	entry = &desc_cache[key % DESC_CACHE_SIZE];
+	if (entry->key == key && entry->epoch == desc_epoch &&
+			entry->obj == obj && entry->mode == mode &&
+			entry->p == p && entry->len < max) {
+		/* Egos and kinds whose name we know are seen */
+		if (obj->known->ego && !(mode & ODESC_SPOIL))
+			obj->ego->everseen = true;
+		if (object_flavor_is_aware(obj) && !(mode & ODESC_SPOIL))
+			obj->kind->everseen = true;
+
+		memcpy(buf, entry->desc, entry->len + 1);
+		return entry->len;
+	}
+
+	end = object_desc_aux(buf, max, obj, mode, p);
+
+	/* Keep it unless it was cut short */
+	if (end + 1 < max && end < DESC_CACHE_LEN) {
+		entry->key = key;
+		entry->epoch = desc_epoch;
+		entry->obj = obj;
+		entry->p = p;
+		entry->mode = mode;
+		entry->len = end;
+		memcpy(entry->desc, buf, end + 1);
+	}
+
+	return end;
+}
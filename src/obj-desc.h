@@ -55,5 +55,6 @@ size_t obj_desc_name_format(char *buf, size_t max, size_t end, const char *fmt,
 							const char *modstr, bool pluralise);
 size_t object_desc(char *buf, size_t max, const struct object *obj,
 	uint32_t mode, const struct player *p);
+void object_desc_forget(void);
 
 #endif /* OBJECT_DESC_H */
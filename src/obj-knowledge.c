@@ -1025,6 +1025,9 @@ void player_know_object(struct player *p, struct object *obj)
 	if (!obj->known) return;
 	if (obj->kind != obj->known->kind) return;
 
+	/* Any cached equipment bonuses may now be out of date */
+	player_bonuses_forget(p);
+
 	/* Distant objects just get base properties */
 	if (obj->kind && !(obj->known->notice & OBJ_NOTICE_ASSESSED)) {
 		object_set_base_known(p, obj);
@@ -25,7 +25,6 @@
 #include "obj-pile.h"
 #include "obj-tval.h"
 #include "obj-util.h"
-#include "project.h"
 
 /**
  * Allocate a new object list.
@@ -167,9 +166,7 @@ void object_list_collect(object_list_t *list)
 	/* Scan each object in the dungeon. */
 	for (i = 1; i < player->cave->obj_max; i++) {
 		object_list_entry_t *entry = NULL;
-		int entry_index;
-		int current_distance;
-		int entry_distance;
+		int j;
 		struct loc grid;
 		int field;
 		bool los = false;
@@ -183,57 +180,34 @@ void object_list_collect(object_list_t *list)
 			grid = obj->grid;
 		}
 
-		/* Determine which section of the list the object entry is in */
-		los = projectable(cave, pgrid, grid, PROJECT_NONE) ||
-			loc_eq(grid, pgrid);
+		/* Determine which section of the list the object entry is in,
+		 * using the view already computed by update_view() */
+		los = square_isview(cave, grid) || loc_eq(grid, pgrid);
 		field = (los) ? OBJECT_LIST_SECTION_LOS : OBJECT_LIST_SECTION_NO_LOS;
 
 		if (object_list_should_ignore_object(player, obj)) continue;
 
-		/* Find or add a list entry. */
-		for (entry_index = 0; entry_index < (int)list->entries_size;
-			 entry_index++) {
-			int j;
-			struct object *list_obj = list->entries[entry_index].object;
-
-			if (list_obj == NULL) {
-				/* We found an empty slot, so add this object here. */
-				list->entries[entry_index].object = obj;
-				for (j = 0; j < OBJECT_LIST_SECTION_MAX; j++)
-					list->entries[entry_index].count[j] = 0;
-				list->entries[entry_index].dy = grid.y - pgrid.y;
-				list->entries[entry_index].dx = grid.x - pgrid.x;
-				entry = &list->entries[entry_index];
-				break;
-			}
-		}
+		/* Each object gets its own entry; entries are filled in order so
+		 * the next free one is always at the end. */
+		if (list->distinct_entries >= list->entries_size)
+			break;
 
-		if (entry == NULL)
-			return;
+		entry = &list->entries[list->distinct_entries++];
+		entry->object = obj;
+		for (j = 0; j < OBJECT_LIST_SECTION_MAX; j++)
+			entry->count[j] = 0;
+		entry->dy = grid.y - pgrid.y;
+		entry->dx = grid.x - pgrid.x;
 
 		/* We only know the number of objects we've actually seen */
 		if (obj->kind == cave->objects[obj->oidx]->kind)
 			entry->count[field] += obj->number;
 		else
 			entry->count[field] = 1;
-
-		/* Store the distance to the object in the stack that is
-		 * closest to the player. */
-		current_distance = (grid.y - pgrid.y) * (grid.y - pgrid.y) +
-			(grid.x - pgrid.x) * (grid.x - pgrid.x);
-		entry_distance = entry->dy * entry->dy + entry->dx * entry->dx;
-
-		if (current_distance < entry_distance) {
-			entry->dy = grid.y - pgrid.y;
-			entry->dx = grid.x - pgrid.x;
-		}
 	}
 
 	/* Collect totals for easier calculations of the list. */
-	for (i = 0; i < (int)list->entries_size; i++) {
-		if (list->entries[i].object == NULL)
-			continue;
-
+	for (i = 0; i < (int)list->distinct_entries; i++) {
 		if (list->entries[i].count[OBJECT_LIST_SECTION_LOS] > 0)
 			list->total_entries[OBJECT_LIST_SECTION_LOS]++;
 
@@ -244,7 +218,6 @@ void object_list_collect(object_list_t *list)
 			list->entries[i].count[OBJECT_LIST_SECTION_LOS];
 		list->total_objects[OBJECT_LIST_SECTION_NO_LOS] +=
 			list->entries[i].count[OBJECT_LIST_SECTION_NO_LOS];
-		list->distinct_entries++;
 	}
 
 	list->creation_turn = turn;
@@ -409,7 +382,7 @@ void object_list_format_name(const object_list_entry_t *entry,
 		has_singular_prefix = true;
 
 	/* Work out if the object is in view */
-	los = projectable(cave, pgrid, grid, PROJECT_NONE) || loc_eq(grid, pgrid);
+	los = square_isview(cave, grid) || loc_eq(grid, pgrid);
 	field = los ? OBJECT_LIST_SECTION_LOS : OBJECT_LIST_SECTION_NO_LOS;
 
 	/*
@@ -217,6 +217,8 @@ static void cleanup_obj_make(void) {
 	}
 	mem_free(money_type);
 	mem_free(alloc_ego_table);
+	alloc_ego_table = NULL;
+	alloc_ego_size = 0;
 	mem_free_alt(obj_total_tval_great);
 	mem_free_alt(obj_total_tval);
 	mem_free_alt(obj_alloc_great);
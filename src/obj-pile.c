@@ -278,12 +278,26 @@ bool pile_contains(const struct object *top, const struct object *obj)
 	return false;
 }
 
+/**
+ * Freed objects kept for reuse, linked through their next pointers; levels
+ * full of items and busy stores create and free a great many objects
+ */
+static struct object *object_pool;
+static int object_pool_num;
+
 /**
  * Create a new object and return it
  */
 struct object *object_new(void)
 {
-	return mem_zalloc(sizeof(struct object));
+	struct object *obj = object_pool;
+
+	if (!obj) return mem_zalloc(sizeof(struct object));
+
+	object_pool = obj->next;
+	object_pool_num--;
+	memset(obj, 0, sizeof(*obj));
+	return obj;
 }
 
 /**
@@ -296,7 +310,28 @@ void object_free(struct object *obj)
 	mem_free(obj->slays);
 	mem_free(obj->brands);
 	mem_free(obj->curses);
-	mem_free(obj);
+
+	if (object_pool_num < OBJECT_POOL_MAX) {
+		obj->next = object_pool;
+		object_pool = obj;
+		object_pool_num++;
+	} else {
+		mem_free(obj);
+	}
+}
+
+/**
+ * Release the memory held for reusing objects
+ */
+void object_pool_free(void)
+{
+	while (object_pool) {
+		struct object *next = object_pool->next;
+
+		mem_free(object_pool);
+		object_pool = next;
+	}
+	object_pool_num = 0;
 }
 
 /**
@@ -349,6 +384,8 @@ void object_delete(struct chunk *c, struct chunk *p_c,
 
 	if (c && c->objects && obj->oidx && (obj == c->objects[obj->oidx]))
 		c->objects[obj->oidx] = NULL;
+	if (c && c->objects && obj->oidx)
+		release_object_slot(c, obj->oidx);
 
 	object_free(obj);
 	*obj_address = NULL;
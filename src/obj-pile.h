@@ -21,6 +21,7 @@
 
 #define OBJECT_LIST_SIZE  128
 #define OBJECT_LIST_INCR  128
+#define OBJECT_POOL_MAX   512
 
 /**
  * Modes for stacking by object_similar()/object_stackable()/object_mergeable()
@@ -50,6 +51,7 @@ typedef enum
 
 struct object *object_new(void);
 void object_free(struct object *obj);
+void object_pool_free(void);
 void object_delete(struct chunk *c, struct chunk *p_c,
 				   struct object **obj_address);
 void object_pile_free(struct chunk *c, struct chunk *p_c, struct object *obj);
@@ -182,32 +182,36 @@ static int16_t art_idx_high_resist[] =	{
 /**
  * Return the artifact power, by generating a "fake" object based on the
  * artifact, and calling the common object_power function
+ *
+ * Unless the randart log is being written, the object is not described.
  */
 static int artifact_power(int a_idx, const char *reason, bool verbose)
 {
 	struct object *obj = object_new();
-	struct object *known_obj = object_new();
-	char buf[256];
 	int32_t power;
 
 	file_putf(log_file, "********** Evaluating %s ********\n", reason);
 	file_putf(log_file, "Artifact index is %d\n", a_idx);
 
 	if (!make_fake_artifact(obj, &a_info[a_idx])) {
-		object_delete(NULL, NULL, &known_obj);
 		object_delete(NULL, NULL, &obj);
 		return 0;
 	}
 
-	object_copy(known_obj, obj);
-	obj->known = known_obj;
-	object_desc(buf, 256 * sizeof(char), obj,
-		ODESC_PREFIX | ODESC_FULL | ODESC_SPOIL, NULL);
-	file_putf(log_file, "%s\n", buf);
+	if (log_file) {
+		struct object *known_obj = object_new();
+		char buf[256];
 
-	power = object_power(obj, verbose, log_file);
+		object_copy(known_obj, obj);
+		obj->known = known_obj;
+		object_desc(buf, sizeof(buf), obj,
+			ODESC_PREFIX | ODESC_FULL | ODESC_SPOIL, NULL);
+		file_putf(log_file, "%s\n", buf);
+		object_delete(NULL, NULL, &known_obj);
+		obj->known = NULL;
+	}
 
-	object_delete(NULL, NULL, &known_obj);
+	power = object_power(obj, verbose && log_file, log_file);
 	object_delete(NULL, NULL, &obj);
 	return power;
 }
@@ -3150,8 +3154,13 @@ static void write_randart_entry(ang_file *fff, const struct artifact *art)
 
 /**
  * Randomize the artifacts
+ *
+ * \param randart_seed is the seed for the new artifact set
+ * \param create_file is whether to write the set to randart.txt
+ * \param create_log is whether to write the details of the generation to
+ * randart.log; that is much slower, so it's only for when the log is wanted
  */
-void do_randart(uint32_t randart_seed, bool create_file)
+void do_randart(uint32_t randart_seed, bool create_file, bool create_log)
 {
 	char fname[1024];
 	struct artifact_set_data *standarts = artifact_set_data_new();
@@ -3161,13 +3170,16 @@ void do_randart(uint32_t randart_seed, bool create_file)
 	Rand_value = randart_seed;
 	Rand_quick = true;
 
-	/* Open the log file for writing */
-	path_build(fname, sizeof(fname), ANGBAND_DIR_USER, "randart.log");
-	log_file = file_open(fname, MODE_WRITE, FTYPE_TEXT);
-	if (!log_file) {
-		msg("Error - can't open randart.log for writing.");
-		artifact_set_data_free(standarts);
-		exit(1);
+	/* Open the log file for writing if it's wanted */
+	if (create_log) {
+		path_build(fname, sizeof(fname), ANGBAND_DIR_USER,
+			"randart.log");
+		log_file = file_open(fname, MODE_WRITE, FTYPE_TEXT);
+		if (!log_file) {
+			msg("Error - can't open randart.log for writing.");
+			artifact_set_data_free(standarts);
+			exit(1);
+		}
 	}
 
 	/* Store the original power ratings */
@@ -3180,6 +3192,9 @@ void do_randart(uint32_t randart_seed, bool create_file)
 	create_artifact_set(standarts);
 	artifact_set_data_free(standarts);
 
+	/* The artifacts have new names and properties */
+	object_desc_forget();
+
 	/* Look at the frequencies on the finished items */
 	randarts = artifact_set_data_new();
 	store_base_power(randarts);
@@ -3187,10 +3202,11 @@ void do_randart(uint32_t randart_seed, bool create_file)
 	artifact_set_data_free(randarts);
 
 	/* Close the log file */
-	if (!file_close(log_file)) {
+	if (log_file && !file_close(log_file)) {
 		msg("Error - can't close randart.log file.");
 		exit(1);
 	}
+	log_file = NULL;
 
 	/* Write a data file if required */
 	if (create_file) {
@@ -3212,6 +3228,7 @@ void do_randart(uint32_t randart_seed, bool create_file)
 		if (!file_close(log_file)) {
 			quit_fmt("Error - can't close %s.", fname);
 		}
+		log_file = NULL;
 	}
 
 	/* When done, resume use of the Angband "complex" RNG. */
@@ -155,6 +155,9 @@ void flavor_init(void)
 {
 	int i, j;
 
+	/* New flavors change what objects are called */
+	object_desc_forget();
+
 	/* Hack -- Use the "simple" RNG */
 	Rand_quick = true;
 
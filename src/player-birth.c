@@ -577,11 +577,9 @@ bool player_make_simple(const char *nrace, const char *nclass,
 	cmd_set_arg_string(cmdq_peek(), "name",
 		(nplayer == NULL) ? "Simple" : nplayer);
 	cmdq_push(CMD_SERVER_CHOICE);
-	/*cmd_set_arg_string(cmdq_peek(), "server",
-		"AP");*/
+	cmd_set_arg_string(cmdq_peek(), "server", "");
 	cmdq_push(CMD_SLOTNAME_CHOICE);
-	/*cmd_set_arg_string(cmdq_peek(), "slotname",
-		"Player");*/
+	cmd_set_arg_string(cmdq_peek(), "slotname", "");
 	cmdq_push(CMD_ACCEPT_CHARACTER);
 	cmdq_execute(CTX_BIRTH);
 
@@ -1312,7 +1310,7 @@ void do_cmd_accept_character(struct command *cmd)
 	/* Now only randomize the artifacts if required */
 	if (OPT(player, birth_randarts)) {
 		seed_randart = randint0(0x10000000);
-		do_randart(seed_randart, true);
+		do_randart(seed_randart, true, false);
 		deactivate_randart_file();
 	}
 
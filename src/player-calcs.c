@@ -1851,6 +1851,197 @@ static void calc_shapechange(struct player_state *state, bool vuln[ELEM_MAX],
 	}
 }
 
+/**
+ * What one equipment slot - the item there plus its curses - adds to the
+ * player's state.  calc_bonuses() is called many times over for a single
+ * item description or comparison, each time with at most one slot holding
+ * something different, so these are kept between calls.
+ *
+ * The race and class part of the state is not kept: it is a handful of
+ * copies, and shapes and timed effects are applied on top of the stat
+ * indices and resistances the items produce, so they cannot be kept apart.
+ */
+struct slot_bonus {
+	const struct object *obj;
+	uint32_t epoch;
+	bitflag flags[OF_SIZE];
+	int stat_add[STAT_MAX];
+	int stealth;
+	int search;
+	int digging;
+	int see_infra;
+	int speed;
+	int dam_red;
+	int blows;
+	int shots;
+	int might;
+	int moves;
+	int res_level[ELEM_MAX];
+	bool vuln[ELEM_MAX];
+	int ac;
+	int to_a;
+	int to_h;
+	int to_d;
+};
+
+/**
+ * Work out what the object in the given slot adds to the player's state
+ */
+static void calc_slot_bonus(struct player *p, int slot, struct object *obj,
+		bool known_only, struct slot_bonus *b)
+{
+	int index = 0, j;
+	struct curse_data *curse = obj->curses;
+	bitflag f[OF_SIZE];
+
+	memset(b, 0, sizeof(*b));
+
+	while (obj) {
+		int dig = 0;
+
+		/* Extract the item flags */
+		if (known_only) {
+			object_flags_known(obj, f);
+		} else {
+			object_flags(obj, f);
+		}
+		of_union(b->flags, f);
+
+		/* Apply modifiers */
+		b->stat_add[STAT_STR] += obj->modifiers[OBJ_MOD_STR]
+			* p->obj_k->modifiers[OBJ_MOD_STR];
+		b->stat_add[STAT_INT] += obj->modifiers[OBJ_MOD_INT]
+			* p->obj_k->modifiers[OBJ_MOD_INT];
+		b->stat_add[STAT_WIS] += obj->modifiers[OBJ_MOD_WIS]
+			* p->obj_k->modifiers[OBJ_MOD_WIS];
+		b->stat_add[STAT_DEX] += obj->modifiers[OBJ_MOD_DEX]
+			* p->obj_k->modifiers[OBJ_MOD_DEX];
+		b->stat_add[STAT_CON] += obj->modifiers[OBJ_MOD_CON]
+			* p->obj_k->modifiers[OBJ_MOD_CON];
+		b->stealth += obj->modifiers[OBJ_MOD_STEALTH]
+			* p->obj_k->modifiers[OBJ_MOD_STEALTH];
+		b->search += (obj->modifiers[OBJ_MOD_SEARCH] * 5)
+			* p->obj_k->modifiers[OBJ_MOD_SEARCH];
+
+		b->see_infra += obj->modifiers[OBJ_MOD_INFRA]
+			* p->obj_k->modifiers[OBJ_MOD_INFRA];
+		if (tval_is_digger(obj)) {
+			if (of_has(obj->flags, OF_DIG_1))
+				dig = 1;
+			else if (of_has(obj->flags, OF_DIG_2))
+				dig = 2;
+			else if (of_has(obj->flags, OF_DIG_3))
+				dig = 3;
+		}
+		dig += obj->modifiers[OBJ_MOD_TUNNEL]
+			* p->obj_k->modifiers[OBJ_MOD_TUNNEL];
+		b->digging += (dig * 20);
+		b->speed += obj->modifiers[OBJ_MOD_SPEED]
+			* p->obj_k->modifiers[OBJ_MOD_SPEED];
+		b->dam_red += obj->modifiers[OBJ_MOD_DAM_RED]
+			* p->obj_k->modifiers[OBJ_MOD_DAM_RED];
+		b->blows += obj->modifiers[OBJ_MOD_BLOWS]
+			* p->obj_k->modifiers[OBJ_MOD_BLOWS];
+		b->shots += obj->modifiers[OBJ_MOD_SHOTS]
+			* p->obj_k->modifiers[OBJ_MOD_SHOTS];
+		b->might += obj->modifiers[OBJ_MOD_MIGHT]
+			* p->obj_k->modifiers[OBJ_MOD_MIGHT];
+		b->moves += obj->modifiers[OBJ_MOD_MOVES]
+			* p->obj_k->modifiers[OBJ_MOD_MOVES];
+
+		/* Apply element info, noting vulnerabilites for later processing */
+		for (j = 0; j < ELEM_MAX; j++) {
+			if (!known_only || obj->known->el_info[j].res_level) {
+				if (obj->el_info[j].res_level == -1)
+					b->vuln[j] = true;
+				if (obj->el_info[j].res_level > b->res_level[j])
+					b->res_level[j] = obj->el_info[j].res_level;
+			}
+		}
+
+		/* Apply combat bonuses */
+		b->ac += obj->ac;
+		if (!known_only || obj->known->to_a)
+			b->to_a += obj->to_a;
+		if (!slot_type_is(p, slot, EQUIP_WEAPON)
+				&& !slot_type_is(p, slot, EQUIP_BOW)) {
+			if (!known_only || obj->known->to_h) {
+				b->to_h += obj->to_h;
+			}
+			if (!known_only || obj->known->to_d) {
+				b->to_d += obj->to_d;
+			}
+		}
+
+		/* Move to any unprocessed curse object */
+		if (curse) {
+			index++;
+			obj = NULL;
+			while (index < z_info->curse_max) {
+				if (curse[index].power) {
+					obj = curses[index].obj;
+					break;
+				} else {
+					index++;
+				}
+			}
+		} else {
+			obj = NULL;
+		}
+	}
+}
+
+/**
+ * Get what the object in the given slot adds to the player's state, using
+ * the cached value where possible.
+ *
+ * Only objects actually carried are cached; hypothetical ones (as used when
+ * describing an item on the floor or in a store) are worked out into
+ * scratch every time.  Nothing is trusted while a bonus update is pending.
+ */
+static const struct slot_bonus *get_slot_bonus(struct player *p, int slot,
+		struct object *obj, bool known_only, struct slot_bonus *scratch)
+{
+	struct player_upkeep *upkeep = p->upkeep;
+	struct slot_bonus *cached;
+
+	if (!upkeep || (upkeep->update & PU_BONUS)) {
+		calc_slot_bonus(p, slot, obj, known_only, scratch);
+		return scratch;
+	}
+
+	if (upkeep->slot_bonus_max < 2 * p->body.count) {
+		mem_free(upkeep->slot_bonus);
+		upkeep->slot_bonus_max = 2 * p->body.count;
+		upkeep->slot_bonus = mem_zalloc(upkeep->slot_bonus_max
+			* sizeof(*upkeep->slot_bonus));
+	}
+	cached = &upkeep->slot_bonus[2 * slot + (known_only ? 1 : 0)];
+	if (cached->obj == obj && cached->epoch == upkeep->bonus_epoch) {
+		return cached;
+	}
+
+	if (!pile_contains(p->gear, obj)) {
+		calc_slot_bonus(p, slot, obj, known_only, scratch);
+		return scratch;
+	}
+	calc_slot_bonus(p, slot, obj, known_only, cached);
+	cached->obj = obj;
+	cached->epoch = upkeep->bonus_epoch;
+	return cached;
+}
+
+/**
+ * Forget all cached slot bonuses; called whenever the player's equipment or
+ * knowledge of it may have changed.
+ */
+void player_bonuses_forget(struct player *p)
+{
+	if (p->upkeep) {
+		p->upkeep->bonus_epoch++;
+	}
+}
+
 /**
  * Calculate the players current "state", taking into account
  * not only race/class intrinsics, but also objects being worn
@@ -1883,7 +2074,6 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 	int extra_moves = 0;
 	struct object *launcher = equipped_item_by_slot_name(p, "shooting");
 	struct object *weapon = equipped_item_by_slot_name(p, "weapon");
-	bitflag f[OF_SIZE];
 	bitflag collect_f[OF_SIZE];
 	bool vuln[ELEM_MAX];
 
@@ -1922,105 +2112,39 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 
 	/* Analyze equipment */
 	for (i = 0; i < p->body.count; i++) {
-		int index = 0;
 		struct object *obj = slot_object(p, i);
-		struct curse_data *curse = obj ? obj->curses : NULL;
+		struct slot_bonus scratch;
+		const struct slot_bonus *b;
 
-		while (obj) {
-			int dig = 0;
-
-			/* Extract the item flags */
-			if (known_only) {
-				object_flags_known(obj, f);
-			} else {
-				object_flags(obj, f);
-			}
-			of_union(collect_f, f);
-
-			/* Apply modifiers */
-			state->stat_add[STAT_STR] += obj->modifiers[OBJ_MOD_STR]
-				* p->obj_k->modifiers[OBJ_MOD_STR];
-			state->stat_add[STAT_INT] += obj->modifiers[OBJ_MOD_INT]
-				* p->obj_k->modifiers[OBJ_MOD_INT];
-			state->stat_add[STAT_WIS] += obj->modifiers[OBJ_MOD_WIS]
-				* p->obj_k->modifiers[OBJ_MOD_WIS];
-			state->stat_add[STAT_DEX] += obj->modifiers[OBJ_MOD_DEX]
-				* p->obj_k->modifiers[OBJ_MOD_DEX];
-			state->stat_add[STAT_CON] += obj->modifiers[OBJ_MOD_CON]
-				* p->obj_k->modifiers[OBJ_MOD_CON];
-			state->skills[SKILL_STEALTH] += obj->modifiers[OBJ_MOD_STEALTH]
-				* p->obj_k->modifiers[OBJ_MOD_STEALTH];
-			state->skills[SKILL_SEARCH] += (obj->modifiers[OBJ_MOD_SEARCH] * 5)
-				* p->obj_k->modifiers[OBJ_MOD_SEARCH];
-
-			state->see_infra += obj->modifiers[OBJ_MOD_INFRA]
-				* p->obj_k->modifiers[OBJ_MOD_INFRA];
-			if (tval_is_digger(obj)) {
-				if (of_has(obj->flags, OF_DIG_1))
-					dig = 1;
-				else if (of_has(obj->flags, OF_DIG_2))
-					dig = 2;
-				else if (of_has(obj->flags, OF_DIG_3))
-					dig = 3;
-			}
-			dig += obj->modifiers[OBJ_MOD_TUNNEL]
-				* p->obj_k->modifiers[OBJ_MOD_TUNNEL];
-			state->skills[SKILL_DIGGING] += (dig * 20);
-			state->speed += obj->modifiers[OBJ_MOD_SPEED]
-				* p->obj_k->modifiers[OBJ_MOD_SPEED];
-			state->dam_red += obj->modifiers[OBJ_MOD_DAM_RED]
-				* p->obj_k->modifiers[OBJ_MOD_DAM_RED];
-			extra_blows += obj->modifiers[OBJ_MOD_BLOWS]
-				* p->obj_k->modifiers[OBJ_MOD_BLOWS];
-			extra_shots += obj->modifiers[OBJ_MOD_SHOTS]
-				* p->obj_k->modifiers[OBJ_MOD_SHOTS];
-			extra_might += obj->modifiers[OBJ_MOD_MIGHT]
-				* p->obj_k->modifiers[OBJ_MOD_MIGHT];
-			extra_moves += obj->modifiers[OBJ_MOD_MOVES]
-				* p->obj_k->modifiers[OBJ_MOD_MOVES];
-
-			/* Apply element info, noting vulnerabilites for later processing */
-			for (j = 0; j < ELEM_MAX; j++) {
-				if (!known_only || obj->known->el_info[j].res_level) {
-					if (obj->el_info[j].res_level == -1)
-						vuln[j] = true;
-
-					/* OK because res_level hasn't included vulnerability yet */
-					if (obj->el_info[j].res_level > state->el_info[j].res_level)
-						state->el_info[j].res_level = obj->el_info[j].res_level;
-				}
-			}
-
-			/* Apply combat bonuses */
-			state->ac += obj->ac;
-			if (!known_only || obj->known->to_a)
-				state->to_a += obj->to_a;
-			if (!slot_type_is(p, i, EQUIP_WEAPON)
-					&& !slot_type_is(p, i, EQUIP_BOW)) {
-				if (!known_only || obj->known->to_h) {
-					state->to_h += obj->to_h;
-				}
-				if (!known_only || obj->known->to_d) {
-					state->to_d += obj->to_d;
-				}
-			}
+		if (!obj) continue;
+		b = get_slot_bonus(p, i, obj, known_only, &scratch);
 
-			/* Move to any unprocessed curse object */
-			if (curse) {
-				index++;
-				obj = NULL;
-				while (index < z_info->curse_max) {
-					if (curse[index].power) {
-						obj = curses[index].obj;
-						break;
-					} else {
-						index++;
-					}
-				}
-			} else {
-				obj = NULL;
-			}
+		of_union(collect_f, b->flags);
+		for (j = 0; j < STAT_MAX; j++) {
+			state->stat_add[j] += b->stat_add[j];
+		}
+		state->skills[SKILL_STEALTH] += b->stealth;
+		state->skills[SKILL_SEARCH] += b->search;
+		state->skills[SKILL_DIGGING] += b->digging;
+		state->see_infra += b->see_infra;
+		state->speed += b->speed;
+		state->dam_red += b->dam_red;
+		extra_blows += b->blows;
+		extra_shots += b->shots;
+		extra_might += b->might;
+		extra_moves += b->moves;
+		for (j = 0; j < ELEM_MAX; j++) {
+			if (b->vuln[j])
+				vuln[j] = true;
+
+			/* OK because res_level hasn't included vulnerability yet */
+			if (b->res_level[j] > state->el_info[j].res_level)
+				state->el_info[j].res_level = b->res_level[j];
 		}
+		state->ac += b->ac;
+		state->to_a += b->to_a;
+		state->to_h += b->to_h;
+		state->to_d += b->to_d;
 	}
 
 	/* Apply the collected flags */
@@ -2344,6 +2468,7 @@ static void update_bonuses(struct player *p)
 	 * Calculate bonuses
 	 * ------------------------------------ */
 
+	player_bonuses_forget(p);
 	calc_bonuses(p, &state, false, true);
 	calc_bonuses(p, &known_state, true, true);
 
@@ -441,6 +441,7 @@ void player_cleanup_members(struct player *p)
 		mem_free(p->upkeep->quiver);
 		mem_free(p->upkeep->inven);
 		mem_free(p->upkeep->steps);
+		mem_free(p->upkeep->slot_bonus);
 		mem_free(p->upkeep);
 		p->upkeep = NULL;
 	}
@@ -492,6 +492,9 @@ struct player_upkeep {
 	int step_count;			/* Pathfinding: number of steps left */
 	int16_t *steps;			/* Pathfinding: steps in reverse order */
 	struct loc path_dest;		/* Pathfinding: destination grid */
+	struct slot_bonus *slot_bonus;	/* Cached per-slot equipment bonuses */
+	int slot_bonus_max;		/* Number of cached slot bonus entries */
+	uint32_t bonus_epoch;		/* Bumped when slot bonuses go stale */
 };
 
 /**
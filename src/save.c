@@ -133,8 +133,7 @@ static void wr_item(const struct object *obj)
 	}
 	wr_byte(obj->notice);
 
-	for (i = 0; i < OF_SIZE; i++)
-		wr_byte(obj->flags[i]);
+	wr_bytes(obj->flags, OF_SIZE);
 
 	for (i = 0; i < OBJ_MOD_MAX; i++) {
 		wr_s16b(obj->modifiers[i]);
@@ -222,14 +221,11 @@ static void wr_monster(const struct monster *mon)
 	wr_byte(mon->energy);
 	wr_byte(MON_TMD_MAX);
 
-	for (j = 0; j < MON_TMD_MAX; j++)
-		wr_s16b(mon->m_timed[j]);
+	wr_s16b_array(mon->m_timed, MON_TMD_MAX);
 
-	for (j = 0; j < MFLAG_SIZE; j++)
-		wr_byte(mon->mflag[j]);
+	wr_bytes(mon->mflag, MFLAG_SIZE);
 
-	for (j = 0; j < OF_SIZE; j++)
-		wr_byte(mon->known_pstate.flags[j]);
+	wr_bytes(mon->known_pstate.flags, OF_SIZE);
 
 	for (j = 0; j < ELEM_MAX; j++)
 		wr_s16b(mon->known_pstate.el_info[j].res_level);
@@ -260,8 +256,6 @@ static void wr_monster(const struct monster *mon)
  */
 static void wr_trap(struct trap *trap)
 {
-	size_t i;
-
 	if (trap->t_idx) {
 		wr_string(trap_info[trap->t_idx].desc);
 	} else {
@@ -272,8 +266,7 @@ static void wr_trap(struct trap *trap)
 	wr_byte(trap->power);
 	wr_byte(trap->timeout);
 
-	for (i = 0; i < TRF_SIZE; i++)
-		wr_byte(trap->flags[i]);
+	wr_bytes(trap->flags, TRF_SIZE);
 }
 
 /**
@@ -443,10 +436,10 @@ void wr_player(void)
 
 	/* Dump the stats (maximum and current and birth and swap-mapping) */
 	wr_byte(STAT_MAX);
-	for (i = 0; i < STAT_MAX; ++i) wr_s16b(player->stat_max[i]);
-	for (i = 0; i < STAT_MAX; ++i) wr_s16b(player->stat_cur[i]);
-	for (i = 0; i < STAT_MAX; ++i) wr_s16b(player->stat_map[i]);
-	for (i = 0; i < STAT_MAX; ++i) wr_s16b(player->stat_birth[i]);
+	wr_s16b_array(player->stat_max, STAT_MAX);
+	wr_s16b_array(player->stat_cur, STAT_MAX);
+	wr_s16b_array(player->stat_map, STAT_MAX);
+	wr_s16b_array(player->stat_birth, STAT_MAX);
 
 	wr_s16b(player->ht_birth);
 	wr_s16b(player->wt_birth);
@@ -501,8 +494,7 @@ void wr_player(void)
 	wr_byte(TMD_MAX);
 
 	/* Read all the effects, in a loop */
-	for (i = 0; i < TMD_MAX; i++)
-		wr_s16b(player->timed[i]);
+	wr_s16b_array(player->timed, TMD_MAX);
 
 	/* Total energy used so far */
 	wr_u32b(player->total_energy);
@@ -523,8 +515,7 @@ void wr_ignore(void)
 	/* Write number of ignore bytes */
 	assert(ignore_size <= 255);
 	wr_byte((uint8_t)ignore_size);
-	for (i = 0; i < ignore_size; i++)
-		wr_byte(ignore_level[i]);
+	wr_bytes(ignore_level, ignore_size);
 
 	/* Write ego-item ignore bits */
 	wr_u16b(z_info->e_max);
@@ -543,8 +534,7 @@ void wr_ignore(void)
 			if (ego_is_ignored(i, j))
 				itype_on(itypes, j);
 
-		for (j = 0; j < ITYPE_SIZE; j++)
-			wr_byte(itypes[j]);
+		wr_bytes(itypes, ITYPE_SIZE);
 	}
 
 	/* Write the current number of aware object auto-inscriptions */
@@ -635,8 +625,7 @@ void wr_misc(void)
 	//	return;
 
 	/* Flags */
-	for (i = 0; i < OF_SIZE; i++)
-		wr_byte(player->obj_k->flags[i]);
+	wr_bytes(player->obj_k->flags, OF_SIZE);
 
 	/* Modifiers */
 	for (i = 0; i < OBJ_MOD_MAX; i++) {
@@ -694,25 +683,18 @@ void wr_artifacts(void)
 
 void wr_player_hp(void)
 {
-	int i;
-
 	wr_u16b(PY_MAX_LEVEL);
-	for (i = 0; i < PY_MAX_LEVEL; i++)
-		wr_s16b(player->player_hp[i]);
+	wr_s16b_array(player->player_hp, PY_MAX_LEVEL);
 }
 
 
 void wr_player_spells(void)
 {
-	int i;
-
 	wr_u16b(player->class->magic.total_spells);
 
-	for (i = 0; i < player->class->magic.total_spells; i++)
-		wr_byte(player->spell_flags[i]);
+	wr_bytes(player->spell_flags, player->class->magic.total_spells);
 
-	for (i = 0; i < player->class->magic.total_spells; i++)
-		wr_byte(player->spell_order[i]);
+	wr_bytes(player->spell_order, player->class->magic.total_spells);
 }
 
 static void wr_gear_aux(struct object *gear)
@@ -749,6 +731,16 @@ void wr_stores(void)
 	int i;
 
 	wr_u16b(z_info->store_max);
+	wr_u32b(store_day);
+	wr_u32b(store_seed);
+
+	/* Save the max depth for the days still owed */
+	wr_u16b(store_owed_num);
+	for (i = 0; i < store_owed_num; i++) {
+		wr_u32b(store_owed[i].last_day);
+		wr_s16b(store_owed[i].depth);
+	}
+
 	for (i = 0; i < z_info->store_max; i++) {
 		const struct store *store = &stores[i];
 		struct object *obj;
@@ -759,6 +751,9 @@ void wr_stores(void)
 		/* Save the stock size */
 		wr_byte(store->stock_num);
 
+		/* Save the day of the last maintenance */
+		wr_u32b(store->maint_day);
+
 		/* Save the stock */
 		for (obj = store->stock; obj; obj = obj->next) {
 			wr_item(obj->known);
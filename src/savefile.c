@@ -118,7 +118,7 @@ static const struct {
 	{ "player hp", wr_player_hp, 1 },
 	{ "player spells", wr_player_spells, 1 },
 	{ "gear", wr_gear, 1 },
-	{ "stores", wr_stores, 1 },
+	{ "stores", wr_stores, 2 },
 	{ "dungeon", wr_dungeon, 1 },
 	{ "objects", wr_objects, 1 },
 	{ "monsters", wr_monsters, 1 },
@@ -147,6 +147,7 @@ static const struct blockinfo loaders[] = {
 	{ "player spells", rd_player_spells, 1 },
 	{ "gear", rd_gear, 1 },	
 	{ "stores", rd_stores, 1 },	
+	{ "stores", rd_stores, 2 },
 	{ "dungeon", rd_dungeon, 1 },
 	{ "objects", rd_objects, 1 },	
 	{ "monsters", rd_monsters, 1 },
@@ -188,33 +189,74 @@ void note(const char *message)
  * Base put/get
  * ------------------------------------------------------------------------ */
 
-static void sf_put(uint8_t v)
+/**
+ * Make room for n more bytes in the save buffer
+ */
+static void sf_reserve(uint32_t n)
 {
 	assert(buffer != NULL);
 	assert(buffer_size > 0);
 
-	if (buffer_size == buffer_pos)
-	{
-		buffer_size += BUFFER_BLOCK_INCREMENT;
+	if (buffer_size - buffer_pos < n) {
+		while (buffer_size - buffer_pos < n)
+			buffer_size += BUFFER_BLOCK_INCREMENT;
 		buffer = mem_realloc(buffer, buffer_size);
 	}
+}
 
-	assert(buffer_pos < buffer_size);
+/**
+ * Check there are n more bytes in the load buffer
+ */
+static void sf_require(uint32_t n)
+{
+	if ((buffer == NULL) || (buffer_size <= 0) || (buffer_pos > buffer_size)
+			|| (buffer_size - buffer_pos < n))
+		quit("Broken savefile - probably from a development version");
+}
 
+static void sf_put(uint8_t v)
+{
+	sf_reserve(1);
 	buffer[buffer_pos++] = v;
 	buffer_check += v;
 }
 
 static uint8_t sf_get(void)
 {
-	if ((buffer == NULL) || (buffer_size <= 0) || (buffer_pos >= buffer_size))
-		quit("Broken savefile - probably from a development version");
-
+	sf_require(1);
 	buffer_check += buffer[buffer_pos];
 
 	return buffer[buffer_pos++];
 }
 
+/**
+ * Put n bytes, as a span; the checksum is the same as for n sf_put() calls
+ */
+static void sf_put_span(const uint8_t *v, uint32_t n)
+{
+	uint32_t i;
+
+	sf_reserve(n);
+	memcpy(buffer + buffer_pos, v, n);
+	for (i = 0; i < n; i++)
+		buffer_check += v[i];
+	buffer_pos += n;
+}
+
+/**
+ * Get n bytes, as a span; the checksum is the same as for n sf_get() calls
+ */
+static void sf_get_span(uint8_t *v, uint32_t n)
+{
+	uint32_t i;
+
+	sf_require(n);
+	memcpy(v, buffer + buffer_pos, n);
+	for (i = 0; i < n; i++)
+		buffer_check += v[i];
+	buffer_pos += n;
+}
+
 
 /**
  * ------------------------------------------------------------------------
@@ -228,8 +270,11 @@ void wr_byte(uint8_t v)
 
 void wr_u16b(uint16_t v)
 {
-	sf_put((uint8_t)(v & 0xFF));
-	sf_put((uint8_t)((v >> 8) & 0xFF));
+	uint8_t b[2];
+
+	b[0] = (uint8_t)(v & 0xFF);
+	b[1] = (uint8_t)((v >> 8) & 0xFF);
+	sf_put_span(b, 2);
 }
 
 void wr_s16b(int16_t v)
@@ -239,10 +284,13 @@ void wr_s16b(int16_t v)
 
 void wr_u32b(uint32_t v)
 {
-	sf_put((uint8_t)(v & 0xFF));
-	sf_put((uint8_t)((v >> 8) & 0xFF));
-	sf_put((uint8_t)((v >> 16) & 0xFF));
-	sf_put((uint8_t)((v >> 24) & 0xFF));
+	uint8_t b[4];
+
+	b[0] = (uint8_t)(v & 0xFF);
+	b[1] = (uint8_t)((v >> 8) & 0xFF);
+	b[2] = (uint8_t)((v >> 16) & 0xFF);
+	b[3] = (uint8_t)((v >> 24) & 0xFF);
+	sf_put_span(b, 4);
 }
 
 void wr_s32b(int32_t v)
@@ -252,12 +300,33 @@ void wr_s32b(int32_t v)
 
 void wr_string(const char *str)
 {
-	while (*str)
-	{
-		wr_byte(*str);
-		str++;
+	sf_put_span((const uint8_t *)str, strlen(str) + 1);
+}
+
+/**
+ * Write an array of bytes; the same as n calls to wr_byte()
+ */
+void wr_bytes(const uint8_t *v, size_t n)
+{
+	sf_put_span(v, n);
+}
+
+/**
+ * Write an array of signed 16-bit values; the same as n calls to wr_s16b()
+ */
+void wr_s16b_array(const int16_t *v, size_t n)
+{
+	size_t i;
+
+	sf_reserve(2 * n);
+	for (i = 0; i < n; i++) {
+		uint16_t u = (uint16_t)v[i];
+		uint8_t lo = (uint8_t)(u & 0xFF), hi = (uint8_t)((u >> 8) & 0xFF);
+
+		buffer[buffer_pos++] = lo;
+		buffer[buffer_pos++] = hi;
+		buffer_check += lo + hi;
 	}
-	wr_byte(*str);
 }
 
 
@@ -268,8 +337,10 @@ void rd_byte(uint8_t *ip)
 
 void rd_u16b(uint16_t *ip)
 {
-	(*ip) = sf_get();
-	(*ip) |= ((uint16_t)(sf_get()) << 8);
+	uint8_t b[2];
+
+	sf_get_span(b, 2);
+	(*ip) = b[0] | ((uint16_t)b[1] << 8);
 }
 
 void rd_s16b(int16_t *ip)
@@ -279,10 +350,11 @@ void rd_s16b(int16_t *ip)
 
 void rd_u32b(uint32_t *ip)
 {
-	(*ip) = sf_get();
-	(*ip) |= ((uint32_t)(sf_get()) << 8);
-	(*ip) |= ((uint32_t)(sf_get()) << 16);
-	(*ip) |= ((uint32_t)(sf_get()) << 24);
+	uint8_t b[4];
+
+	sf_get_span(b, 4);
+	(*ip) = b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16)
+		| ((uint32_t)b[3] << 24);
 }
 
 void rd_s32b(int32_t *ip)
@@ -305,15 +377,41 @@ void rd_string(char *str, int max)
 	str[max - 1] = '\0';
 }
 
+/**
+ * Read an array of bytes; the same as n calls to rd_byte()
+ */
+void rd_bytes(uint8_t *v, size_t n)
+{
+	sf_get_span(v, n);
+}
+
+/**
+ * Read an array of signed 16-bit values; the same as n calls to rd_s16b()
+ */
+void rd_s16b_array(int16_t *v, size_t n)
+{
+	size_t i;
+
+	sf_require(2 * n);
+	for (i = 0; i < n; i++) {
+		uint8_t lo = buffer[buffer_pos++], hi = buffer[buffer_pos++];
+
+		buffer_check += lo + hi;
+		v[i] = (int16_t)(lo | ((uint16_t)hi << 8));
+	}
+}
+
 void strip_bytes(int n)
 {
-	uint8_t tmp8u;
-	while (n--) rd_byte(&tmp8u);
+	sf_require(n);
+	while (n--) buffer_check += buffer[buffer_pos++];
 }
 
 void pad_bytes(int n)
 {
-	while (n--) wr_byte(0);
+	sf_reserve(n);
+	memset(buffer + buffer_pos, 0, n);
+	buffer_pos += n;
 }
 
 
@@ -504,12 +602,13 @@ static errr next_blockheader(ang_file *f, struct blockheader *b) {
  * Find the right loader for this block, return it
  */
 static loader_t find_loader(struct blockheader *b,
-							const struct blockinfo *local_loaders)
+							const struct blockinfo *local_loaders,
+							size_t n)
 {
 	size_t i = 0;
 
 	/* Find the right loader */
-	for (i = 0; local_loaders[i].name[0]; i++) {
+	for (i = 0; i < n; i++) {
 		if (!streq(b->name, local_loaders[i].name)) continue;
 		if (b->version != local_loaders[i].version) continue;
 
@@ -563,7 +662,8 @@ static void skip_block(ang_file *f, struct blockheader *b)
 /**
  * Try to load a savefile
  */
-static bool try_load(ang_file *f, const struct blockinfo *local_loaders)
+static bool try_load(ang_file *f, const struct blockinfo *local_loaders,
+		size_t n_loaders)
 {
 	struct blockheader b;
 	errr err;
@@ -575,7 +675,7 @@ static bool try_load(ang_file *f, const struct blockinfo *local_loaders)
 
 	/* Get the next block header */
 	while ((err = next_blockheader(f, &b)) == 0) {
-		loader_t loader = find_loader(&b, local_loaders);
+		loader_t loader = find_loader(&b, local_loaders, n_loaders);
 		if (!loader) {
 			note("Savefile block can't be read.");
 			note("Maybe try and load the savefile in an earlier version of Angband.");
@@ -653,7 +753,7 @@ bool savefile_load(const char *path, bool cheat_death)
 		return false;
 	}
 
-	ok = try_load(f, loaders);
+	ok = try_load(f, loaders, N_ELEMENTS(loaders));
 	file_close(f);
 
 	if (player->is_dead && cheat_death) {
@@ -70,6 +70,8 @@ void wr_s16b(int16_t v);
 void wr_u32b(uint32_t v);
 void wr_s32b(int32_t v);
 void wr_string(const char *str);
+void wr_bytes(const uint8_t *v, size_t n);
+void wr_s16b_array(const int16_t *v, size_t n);
 void pad_bytes(int n);
 
 /* Reading bits */
@@ -79,6 +81,8 @@ void rd_s16b(int16_t *ip);
 void rd_u32b(uint32_t *ip);
 void rd_s32b(int32_t *ip);
 void rd_string(char *str, int max);
+void rd_bytes(uint8_t *v, size_t n);
+void rd_s16b_array(int16_t *v, size_t n);
 void strip_bytes(int n);
 
 
@@ -44,7 +44,7 @@
 #include "debug.h"
 
 
-static void store_maint(struct store *s);
+static void store_maint(struct store *s, int depth);
 
 /**
  * ------------------------------------------------------------------------
@@ -62,6 +62,29 @@ struct store *stores;
  */
 struct hint *hints;
 
+/**
+ * Days of store maintenance that have been owed so far; each store catches
+ * up to this when it is next looked at
+ */
+uint32_t store_day;
+
+/**
+ * Seed from which each store's maintenance for each day is rolled
+ */
+uint32_t store_seed;
+
+/**
+ * The player's max depth on the owed days, as runs of days each ending on
+ * its last_day; runs every store has caught up past are dropped
+ */
+struct store_owed *store_owed;
+uint16_t store_owed_num;
+
+/**
+ * Days of maintenance a store gets before its first visit
+ */
+#define STORE_INITIAL_DAYS 10
+
 
 static const char *obj_flags[] = {
 	"NONE",
@@ -118,6 +141,9 @@ static void cleanup_stores(void)
 		}
 	}
 	mem_free(stores);
+	mem_free(store_owed);
+	store_owed = NULL;
+	store_owed_num = 0;
 }
 
 
@@ -338,9 +364,12 @@ void store_init(void)
 }
 
 void store_reset(void) {
-	int i, j;
+	int i;
 	struct store *s;
 
+	store_day = 0;
+	store_seed = randint0(0x10000000);
+	store_owed_num = 0;
 	for (i = 0; i < z_info->store_max; i++) {
 		s = &stores[i];
 		s->stock_num = 0;
@@ -349,11 +378,12 @@ void store_reset(void) {
 		object_pile_free(NULL, NULL, s->stock);
 		s->stock_k = NULL;
 		s->stock = NULL;
-		if (s->feat == FEAT_HOME)
-			continue;
-		for (j = 0; j < 10; j++)
-			store_maint(s);
+
+		/* Stock the store when it is first looked at */
+		s->maint_day = store_day;
 	}
+	store_day += STORE_INITIAL_DAYS;
+	store_owe_days(store_day, player->max_depth);
 }
 
 
@@ -774,7 +804,8 @@ static void mass_produce(struct object *obj)
 
 
 /**
- * Sort the store inventory into an ordered array.
+ * Sort the store inventory into an ordered array.  The store is brought up
+ * to date first.
  */
 void store_stock_list(struct store *store, struct object **list, int n)
 {
@@ -782,6 +813,8 @@ void store_stock_list(struct store *store, struct object **list, int n)
 	int list_num;
 	int num = 0;
 
+	store_catch_up(store);
+
 	for (list_num = 0; list_num < n; list_num++) {
 		struct object *current, *first = NULL;
 		for (current = store->stock; current; current = current->next) {
@@ -1151,9 +1184,10 @@ static struct object_kind *store_get_choice(struct store *store)
 
 
 /**
- * Creates a random object and gives it to store 'store'
+ * Creates a random object and gives it to store 'store', choosing from
+ * levels suited to a player whose max depth is 'depth'
  */
-static bool store_create_random(struct store *store)
+static bool store_create_random(struct store *store, int depth)
 {
 	int tries, level;
 
@@ -1161,11 +1195,11 @@ static bool store_create_random(struct store *store)
 
 	/* Decide min/max levels */
 	if (store->feat == FEAT_STORE_BLACK) {
-		min_level = player->max_depth + 5;
-		max_level = player->max_depth + 20;
+		min_level = depth + 5;
+		max_level = depth + 20;
 	} else {
 		min_level = 1;
-		max_level = z_info->store_magic_level + MAX(player->max_depth - 20, 0);
+		max_level = z_info->store_magic_level + MAX(depth - 20, 0);
 	}
 
 	if (min_level > 55) min_level = 55;
@@ -1289,9 +1323,10 @@ static struct object *store_create_item(struct store *store,
 }
 
 /**
- * Maintain the inventory at the stores.
+ * Maintain the inventory at the stores, for a player whose max depth is
+ * 'depth'.
  */
-static void store_maint(struct store *s)
+static void store_maint(struct store *s, int depth)
 {
 	/* Ignore home */
 	if (s->feat == FEAT_HOME)
@@ -1407,7 +1442,7 @@ static void store_maint(struct store *s)
 		/* The (huge) restock_attempts will only go to zero (otherwise
 		 * infinite loop) if stores don't have enough items they can stock! */
 		while (s->stock_num < stock && --restock_attempts)
-			store_create_random(s);
+			store_create_random(s, depth);
 
 		if (!restock_attempts)
 			quit_fmt("Unable to (re-)stock %s. Please report this bug",
@@ -1416,50 +1451,143 @@ static void store_maint(struct store *s)
 	}
 }
 
+/**
+ * Record that the stores are owed maintenance up to a day, on which the
+ * player's max depth was 'depth'.
+ */
+void store_owe_days(uint32_t last_day, int depth)
+{
+	if (store_owed_num && store_owed[store_owed_num - 1].depth == depth) {
+		store_owed[store_owed_num - 1].last_day = last_day;
+		return;
+	}
+	store_owed = mem_realloc(store_owed,
+		(store_owed_num + 1) * sizeof(*store_owed));
+	store_owed[store_owed_num].last_day = last_day;
+	store_owed[store_owed_num].depth = depth;
+	store_owed_num++;
+}
+
+/**
+ * Drop the runs of owed days which every store has caught up past.
+ */
+static void store_forget_owed(void)
+{
+	uint32_t first = store_day;
+	int i, n = 0;
+
+	for (i = 0; i < z_info->store_max; i++) {
+		if (stores[i].feat == FEAT_HOME) continue;
+		first = MIN(first, stores[i].maint_day);
+	}
+	while (n < store_owed_num && store_owed[n].last_day <= first) n++;
+	if (!n) return;
+	store_owed_num -= n;
+	memmove(store_owed, store_owed + n, store_owed_num * sizeof(*store_owed));
+}
+
 /**
  * Update the stores on the return to town.
+ *
+ * This only records the days that have passed and the player's max depth;
+ * the stores do the work in store_catch_up() when one is next looked at.
  */
 void store_update(void)
 {
-	if (OPT(player, cheat_xtra)) msg("Updating Shops...");
-	while (daycount--) {
-		int n;
+	if (!daycount) return;
+	store_day += daycount;
+	store_owe_days(store_day, player->max_depth);
+	daycount = 0;
+}
 
-		/* Maintain each shop (except home) */
-		for (n = 0; n < z_info->store_max; n++) {
-			/* Skip the home */
-			if (stores[n].feat == FEAT_HOME) continue;
+/**
+ * Get the seed for one store's maintenance on one day.
+ */
+static uint32_t store_day_seed(const struct store *s, uint32_t day)
+{
+	uint32_t h = store_seed ^ ((uint32_t)(s - stores) * 0x9E3779B9u);
+
+	h ^= day * 0x85EBCA6Bu;
+	h ^= h >> 16;
+	h *= 0x7FEB352Du;
+	h ^= h >> 15;
+	h *= 0x846CA68Bu;
+	h ^= h >> 16;
+	return h;
+}
 
-			/* Maintain */
-			store_maint(&stores[n]);
+/**
+ * Bring the stores up to date with the days that have passed since they were
+ * last maintained.
+ *
+ * The black market turns away kinds the other stores have in stock, so all
+ * the stores go forward together a day at a time, as they did when every
+ * store was maintained on the return to town.  Each store's day is rolled
+ * with the simple RNG from its own seed, and stocked for the max depth the
+ * player had when the day was owed, so the result does not depend on when
+ * the stores are looked at, and the main RNG is left alone.  A shop-keeper
+ * is shuffled on a day with the same chance as when one random shop was
+ * picked for it each day.
+ */
+void store_catch_up(struct store *s)
+{
+	bool old_quick;
+	uint32_t old_value, day, first = store_day;
+	int n, n_without_home = 0, run = 0;
+
+	if (!s || s->maint_day == store_day) return;
+
+	/* Looking in the home leaves the other stores alone */
+	if (s->feat == FEAT_HOME) {
+		s->maint_day = store_day;
+		return;
+	}
+
+	for (n = 0; n < z_info->store_max; n++) {
+		/* The home is never maintained */
+		if (stores[n].feat == FEAT_HOME) {
+			stores[n].maint_day = store_day;
+			continue;
+		}
+		n_without_home++;
+		first = MIN(first, stores[n].maint_day);
+	}
+
+	old_quick = Rand_quick;
+	old_value = Rand_value;
+	Rand_quick = true;
+	for (day = first + 1; day <= store_day; day++) {
+		int depth;
+
+		/* Find the max depth the player had on that day */
+		while (run < store_owed_num && store_owed[run].last_day < day) {
+			run++;
 		}
+		depth = (run < store_owed_num) ? store_owed[run].depth :
+			player->max_depth;
 
-		/* Sometimes, shuffle the shop-keepers */
-		if (one_in_(z_info->store_shuffle)) {
-			int *non_home_inds = mem_zalloc(z_info->store_max
-				* sizeof(*non_home_inds));
-			int n_without_home = 0;
+		for (n = 0; n < z_info->store_max; n++) {
+			struct store *st = &stores[n];
 
-			/* Message */
-			if (OPT(player, cheat_xtra)) msg("Shuffling a Shopkeeper...");
+			if (st->maint_day >= day) continue;
+			st->maint_day = day;
+			Rand_value = store_day_seed(st, day);
 
-			/* Pick a random shop (except home) */
-			for (n = 0; n < z_info->store_max; n++) {
-				if (stores[n].feat != FEAT_HOME) {
-					non_home_inds[n_without_home] = n;
-					++n_without_home;
+			/* Maintain */
+			store_maint(st, depth);
+
+			/* Sometimes, shuffle the shop-keeper */
+			if (one_in_(z_info->store_shuffle * n_without_home)) {
+				if (OPT(player, cheat_xtra)) {
+					msg("Shuffling a Shopkeeper...");
 				}
+				store_shuffle(st);
 			}
-			if (n_without_home > 0) {
-				n = randint0(n_without_home);
-				/* Then suffle it. */
-				store_shuffle(&stores[non_home_inds[n]]);
-			}
-			mem_free(non_home_inds);
 		}
 	}
-	daycount = 0;
-	if (OPT(player, cheat_xtra)) msg("Done.");
+	Rand_value = old_value;
+	Rand_quick = old_quick;
+	store_forget_owed();
 }
 
 /** Owner stuff **/
@@ -1768,7 +1896,7 @@ void do_cmd_buy(struct command *cmd)
 
 			/* New inventory */
 			for (i = 0; i < 10; ++i)
-				store_maint(store);
+				store_maint(store, player->max_depth);
 		}
 	}
 
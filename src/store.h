@@ -64,9 +64,23 @@ struct store {
 	int turnover;
 	int normal_stock_min;
 	int normal_stock_max;
+
+	uint32_t maint_day;		/* Value of store_day when last maintained */
+};
+
+/**
+ * A run of days of store maintenance owed at one max depth
+ */
+struct store_owed {
+	uint32_t last_day;
+	int16_t depth;
 };
 
 extern struct store *stores;
+extern uint32_t store_day;
+extern uint32_t store_seed;
+extern struct store_owed *store_owed;
+extern uint16_t store_owed_num;
 
 struct store *store_at(struct chunk *c, struct loc grid);
 void store_init(void);
@@ -76,7 +90,9 @@ void home_carry(struct object *obj);
 struct object *store_carry(struct store *store, struct object *obj);
 void store_reset(void);
 void store_shuffle(struct store *store);
+void store_owe_days(uint32_t last_day, int depth);
 void store_update(void);
+void store_catch_up(struct store *s);
 int price_item(struct store *store, const struct object *obj,
 			   bool store_buying, int qty);
 
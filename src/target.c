@@ -450,33 +450,43 @@ struct point_set *target_get_monsters(int mode, monster_predicate pred,
 		max_x = player->grid.x + z_info->max_range + 1;
 	}
 
-	/* Scan for targets */
-	for (y = min_y; y < max_y; y++) {
-		for (x = min_x; x < max_x; x++) {
-			struct loc grid = loc(x, y);
-
+	if (mode & (TARGET_KILL)) {
+		/* Only grids with monsters will do, so just look at those */
+		struct nearby_iter iter;
+		struct monster *mon;
+
+		nearby_monsters_rect(&iter, cave, loc(min_x, min_y),
+			loc(max_x - 1, max_y - 1));
+		while ((mon = nearby_monsters_next(&iter))) {
 			/* Check bounds */
-			if (!square_in_bounds_fully(cave, grid)) continue;
+			if (!square_in_bounds_fully(cave, mon->grid)) continue;
 
 			/* Require "interesting" contents */
-			if (!target_accept(y, x)) continue;
-
-			/* Special mode */
-			if (mode & (TARGET_KILL)) {
-				struct monster *mon = square_monster(cave, grid);
+			if (!target_accept(mon->grid.y, mon->grid.x)) continue;
 
-				/* Must contain a monster */
-				if (mon == NULL) continue;
+			/* Must be a targettable monster */
+			if (!target_able(mon)) continue;
 
-				/* Must be a targettable monster */
-				if (!target_able(mon)) continue;
-
-				/* Must be the right sort of monster */
-				if (pred && !pred(mon)) continue;
-			}
+			/* Must be the right sort of monster */
+			if (pred && !pred(mon)) continue;
 
 			/* Save the location */
-			add_to_point_set(targets, grid);
+			add_to_point_set(targets, mon->grid);
+		}
+	} else {
+		/* Scan for targets */
+		for (y = min_y; y < max_y; y++) {
+			for (x = min_x; x < max_x; x++) {
+				/* Check bounds */
+				if (!square_in_bounds_fully(cave, loc(x, y)))
+					continue;
+
+				/* Require "interesting" contents */
+				if (!target_accept(y, x)) continue;
+
+				/* Save the location */
+				add_to_point_set(targets, loc(x, y));
+			}
 		}
 	}
 
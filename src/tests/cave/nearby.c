@@ -0,0 +1,233 @@
+/* cave/nearby */
+/* Check walks through the monsters near a place against looking at them all. */
+
+#include "unit-test.h"
+#include "unit-test-data.h"
+#include "cave.h"
+#include "init.h"
+#include "monster.h"
+#include "z-rand.h"
+#include "z-virt.h"
+
+#define TEST_MONSTERS 64
+
+/* Where each test monster stands, or (-1, -1) if it is not on the level */
+static struct loc where[TEST_MONSTERS];
+
+int setup_tests(void **state) {
+	struct chunk *c;
+	int i;
+
+	Rand_init();
+	z_info = mem_zalloc(sizeof(*z_info));
+	z_info->level_monster_max = TEST_MONSTERS;
+	f_info = mem_zalloc(FEAT_MAX * sizeof(*f_info));
+	flag_on(f_info[FEAT_FLOOR].flags, TF_SIZE, TF_LOS);
+	flag_on(f_info[FEAT_FLOOR].flags, TF_SIZE, TF_PROJECT);
+	flag_on(f_info[FEAT_FLOOR].flags, TF_SIZE, TF_PASSABLE);
+	c = cave_new(45, 70);
+	for (i = 0; i < TEST_MONSTERS; i++) {
+		c->monsters[i].midx = i;
+		where[i] = loc(-1, -1);
+	}
+	*state = c;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cave_free(state);
+	mem_free(f_info);
+	f_info = NULL;
+	mem_free(z_info);
+	z_info = NULL;
+	return 0;
+}
+
+static struct loc random_grid(struct chunk *c)
+{
+	return loc(randint0(c->width), randint0(c->height));
+}
+
+/*
+ * Put down, move, swap, renumber and take away monsters at random, the way
+ * the game does through square_set_mon().
+ */
+static void shuffle_monsters(struct chunk *c, int turns)
+{
+	while (turns--) {
+		int midx = randint1(TEST_MONSTERS - 1);
+		struct loc grid = random_grid(c);
+		int other = square(c, grid)->mon;
+
+		if (where[midx].x < 0) {
+			/* Place a new monster on an empty grid */
+			if (other) continue;
+			square_set_mon(c, grid, midx);
+			where[midx] = grid;
+		} else if (one_in_(6)) {
+			/* Delete it */
+			square_set_mon(c, where[midx], 0);
+			where[midx] = loc(-1, -1);
+		} else if (one_in_(6)) {
+			/* Give it a free index, as compacting does */
+			int i2 = randint1(TEST_MONSTERS - 1);
+
+			if (where[i2].x >= 0) continue;
+			square_set_mon(c, where[midx], i2);
+			where[i2] = where[midx];
+			where[midx] = loc(-1, -1);
+		} else {
+			/* Swap it with whatever is at the grid, as monster_swap() */
+			struct loc from = where[midx];
+
+			square_set_mon(c, from, other);
+			square_set_mon(c, grid, midx);
+			if (other > 0) where[other] = from;
+			where[midx] = grid;
+		}
+	}
+}
+
+/*
+ * Check that a walk gives each monster the test wants exactly once, and no
+ * others.
+ */
+static bool walk_matches(struct chunk *c, struct nearby_iter *iter,
+		bool (*want)(struct loc grid, void *data), void *data)
+{
+	bool seen[TEST_MONSTERS] = { false };
+	struct monster *mon;
+	int i;
+
+	while ((mon = nearby_monsters_next(iter))) {
+		int midx = mon - c->monsters;
+
+		if (midx <= 0 || midx >= TEST_MONSTERS || seen[midx] ||
+			where[midx].x < 0 || !want(where[midx], data)) return false;
+		seen[midx] = true;
+	}
+	for (i = 1; i < TEST_MONSTERS; i++) {
+		if (where[i].x >= 0 && !seen[i] && want(where[i], data))
+			return false;
+	}
+	return true;
+}
+
+struct rect {
+	struct loc top_left, bottom_right;
+};
+
+static bool in_rect(struct loc grid, void *data)
+{
+	struct rect *r = data;
+
+	return grid.x >= r->top_left.x && grid.y >= r->top_left.y &&
+		grid.x <= r->bottom_right.x && grid.y <= r->bottom_right.y;
+}
+
+struct circle {
+	struct chunk *c;
+	struct loc centre;
+	int radius;
+	bool need_los;
+};
+
+static bool in_circle(struct loc grid, void *data)
+{
+	struct circle *r = data;
+
+	if (distance(r->centre, grid) > r->radius) return false;
+	return !r->need_los || los(r->c, r->centre, grid);
+}
+
+static int test_rect(void *state) {
+	struct chunk *c = state;
+	int i;
+
+	for (i = 0; i < 300; i++) {
+		struct nearby_iter iter;
+		struct rect r;
+
+		shuffle_monsters(c, 20);
+		r.top_left = loc(randint0(c->width + 10) - 5,
+			randint0(c->height + 10) - 5);
+		r.bottom_right = loc(r.top_left.x + randint0(40) - 3,
+			r.top_left.y + randint0(30) - 3);
+		nearby_monsters_rect(&iter, c, r.top_left, r.bottom_right);
+		require(walk_matches(c, &iter, in_rect, &r));
+	}
+	ok;
+}
+
+static int test_radius(void *state) {
+	struct chunk *c = state;
+	int i;
+
+	for (i = 0; i < 300; i++) {
+		struct nearby_iter iter;
+		struct circle r = { c, random_grid(c), randint0(30), false };
+
+		shuffle_monsters(c, 20);
+		nearby_monsters_radius(&iter, c, r.centre, r.radius);
+		require(walk_matches(c, &iter, in_circle, &r));
+	}
+	ok;
+}
+
+static int test_los(void *state) {
+	struct chunk *c = state;
+	struct loc grid;
+	int i;
+
+	for (grid.y = 0; grid.y < c->height; grid.y++) {
+		for (grid.x = 0; grid.x < c->width; grid.x++) {
+			square_set_feat(c, grid, one_in_(5) ? FEAT_GRANITE :
+				FEAT_FLOOR);
+		}
+	}
+	for (i = 0; i < 100; i++) {
+		struct nearby_iter iter;
+		struct circle r = { c, random_grid(c), randint0(20), true };
+
+		shuffle_monsters(c, 20);
+		nearby_monsters_los(&iter, c, r.centre, r.radius);
+		require(walk_matches(c, &iter, in_circle, &r));
+	}
+	ok;
+}
+
+static int test_delete(void *state) {
+	struct chunk *c = state;
+	struct circle r = { c, loc(30, 20), 15, false };
+	struct nearby_iter iter;
+	struct monster *mon;
+	int i, wanted = 0, deleted = 0;
+
+	shuffle_monsters(c, 500);
+	for (i = 1; i < TEST_MONSTERS; i++) {
+		if (where[i].x >= 0 && in_circle(where[i], &r)) wanted++;
+	}
+
+	/* Taking away each monster as it comes does not upset the walk */
+	nearby_monsters_radius(&iter, c, r.centre, r.radius);
+	while ((mon = nearby_monsters_next(&iter))) {
+		int midx = mon - c->monsters;
+
+		square_set_mon(c, where[midx], 0);
+		where[midx] = loc(-1, -1);
+		deleted++;
+	}
+	eq(deleted, wanted);
+	nearby_monsters_radius(&iter, c, r.centre, r.radius);
+	null(nearby_monsters_next(&iter));
+	ok;
+}
+
+const char *suite_name = "cave/nearby";
+struct test tests[] = {
+	{ "rect", test_rect },
+	{ "radius", test_radius },
+	{ "los", test_los },
+	{ "delete", test_delete },
+	{ NULL, NULL },
+};
@@ -0,0 +1,198 @@
+/* cave/region */
+/* Check connected regions against a flood fill of the chunk. */
+
+#include "unit-test.h"
+#include "unit-test-data.h"
+#include "cave.h"
+#include "generate.h"
+#include "z-rand.h"
+#include "z-virt.h"
+
+int setup_tests(void **state) {
+	Rand_init();
+	z_info = &test_z_info;
+	f_info = mem_zalloc(FEAT_MAX * sizeof(*f_info));
+	flag_on(f_info[FEAT_FLOOR].flags, TF_SIZE, TF_PASSABLE);
+	flag_on(f_info[FEAT_OPEN].flags, TF_SIZE, TF_PASSABLE);
+	flag_on(f_info[FEAT_OPEN].flags, TF_SIZE, TF_DOOR_ANY);
+	flag_on(f_info[FEAT_CLOSED].flags, TF_SIZE, TF_DOOR_ANY);
+	flag_on(f_info[FEAT_PASS_RUBBLE].flags, TF_SIZE, TF_PASSABLE);
+	*state = cave_new(21, 33);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cave_free(state);
+	mem_free(f_info);
+	f_info = NULL;
+	return 0;
+}
+
+static void random_terrain(struct chunk *c, int open)
+{
+	int feats[] = { FEAT_FLOOR, FEAT_OPEN, FEAT_CLOSED, FEAT_PASS_RUBBLE };
+	struct loc grid;
+
+	for (grid.y = 0; grid.y < c->height; grid.y++) {
+		for (grid.x = 0; grid.x < c->width; grid.x++) {
+			square_set_feat(c, grid, randint0(100) < open ?
+				feats[randint0(N_ELEMENTS(feats))] : FEAT_GRANITE);
+		}
+	}
+}
+
+static bool is_open(struct chunk *c, struct loc grid)
+{
+	return square_ispassable(c, grid) || square_isdoor(c, grid);
+}
+
+/*
+ * Label each open grid by flooding from it, and check that the regions
+ * agree with the labels and have the right sizes.
+ */
+static bool same_as_flood(struct chunk *c, struct cave_regions *r,
+		bool diagonal)
+{
+	int size = c->height * c->width;
+	int *label = mem_zalloc(size * sizeof(*label));
+	int *stack = mem_alloc(size * sizeof(*stack));
+	int *label_size = mem_zalloc((size + 1) * sizeof(*label_size));
+	int *region_label = mem_zalloc(size * sizeof(*region_label));
+	int labels = 0, n;
+	bool same = true;
+
+	for (n = 0; n < size; n++) {
+		struct loc grid;
+		int top = 0;
+
+		i_to_grid(n, c->width, &grid);
+		if (label[n] || !is_open(c, grid)) continue;
+		label[n] = ++labels;
+		stack[top++] = n;
+		while (top) {
+			int m = stack[--top], i;
+			struct loc from;
+
+			label_size[labels]++;
+			i_to_grid(m, c->width, &from);
+			for (i = 0; i < (diagonal ? 8 : 4); i++) {
+				struct loc adj = loc_sum(from, ddgrid_ddd[i]);
+				int k;
+
+				if (!square_in_bounds(c, adj)) continue;
+				k = grid_to_i(adj, c->width);
+				if (label[k] || !is_open(c, adj)) continue;
+				label[k] = labels;
+				stack[top++] = k;
+			}
+		}
+	}
+
+	if (r->num != labels) same = false;
+	for (n = 0; n < size && same; n++) {
+		struct loc grid;
+		int region;
+
+		i_to_grid(n, c->width, &grid);
+		region = cave_region_find(r, grid);
+		if (!label[n]) {
+			if (region != -1) same = false;
+			continue;
+		}
+
+		/* Regions are named by their first grid */
+		if (region < 0 || region > n) {
+			same = false;
+		} else if (region == n) {
+			region_label[region] = label[n];
+			if (cave_region_size(r, region) != label_size[label[n]])
+				same = false;
+		} else if (region_label[region] != label[n]) {
+			same = false;
+		}
+	}
+
+	mem_free(region_label);
+	mem_free(label_size);
+	mem_free(stack);
+	mem_free(label);
+	return same;
+}
+
+static int test_build(void *state) {
+	struct chunk *c = state;
+	int open, diagonal;
+
+	for (open = 0; open <= 100; open += 10) {
+		for (diagonal = 0; diagonal < 2; diagonal++) {
+			struct cave_regions *r;
+
+			random_terrain(c, open);
+			r = cave_regions_new(c, diagonal);
+			require(same_as_flood(c, r, diagonal));
+			cave_regions_free(r);
+		}
+	}
+	ok;
+}
+
+static int test_open(void *state) {
+	struct chunk *c = state;
+	struct cave_regions *r;
+	int i;
+
+	/* Dig tunnels one grid at a time */
+	random_terrain(c, 30);
+	r = cave_regions_new(c, false);
+	for (i = 0; i < 200; i++) {
+		struct loc grid = loc(randint0(c->width), randint0(c->height));
+
+		square_set_feat(c, grid, FEAT_FLOOR);
+		cave_region_open(r, grid);
+		require(same_as_flood(c, r, false));
+	}
+	cave_regions_free(r);
+	ok;
+}
+
+static int test_connected(void *state) {
+	struct chunk *c = state;
+	int i;
+
+	random_terrain(c, 45);
+	for (i = 0; i < 500; i++) {
+		struct loc grid1 = loc(randint0(c->width), randint0(c->height));
+		struct loc grid2 = loc(randint0(c->width), randint0(c->height));
+		int region;
+
+		/* The chunk follows its own changes, including walls */
+		square_set_feat(c, grid1, one_in_(3) ? FEAT_GRANITE : FEAT_FLOOR);
+		(void) cave_connected(c, grid1, grid2);
+		require(same_as_flood(c, c->regions, true));
+
+		region = cave_region_find(c->regions, grid1);
+		eq(cave_connected(c, grid1, grid2), region >= 0 &&
+			region == cave_region_find(c->regions, grid2));
+	}
+
+	/* A wall across the chunk cuts it in two */
+	for (i = 0; i < c->height; i++) {
+		square_set_feat(c, loc(0, i), FEAT_FLOOR);
+		square_set_feat(c, loc(1, i), FEAT_GRANITE);
+		square_set_feat(c, loc(2, i), FEAT_FLOOR);
+	}
+	require(cave_connected(c, loc(0, 0), loc(0, c->height - 1)));
+	require(!cave_connected(c, loc(0, 0), loc(2, 0)));
+	square_set_feat(c, loc(1, 5), FEAT_CLOSED);
+	require(cave_connected(c, loc(0, 0), loc(2, 0)));
+	require(!c->regions->stale);
+	ok;
+}
+
+const char *suite_name = "cave/region";
+struct test tests[] = {
+	{ "build", test_build },
+	{ "open", test_open },
+	{ "connected", test_connected },
+	{ NULL, NULL },
+};
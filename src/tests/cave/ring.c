@@ -0,0 +1,77 @@
+/* cave/ring */
+/* Check distance_ring() against a scan of the whole chunk. */
+
+#include "unit-test.h"
+#include "unit-test-data.h"
+#include "cave.h"
+#include "z-virt.h"
+
+int setup_tests(void **state) {
+	z_info = &test_z_info;
+	*state = cave_new(23, 37);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cave_free(state);
+	return 0;
+}
+
+static int test_same_as_scan(void *state) {
+	struct chunk *c = state;
+	struct loc centres[] = {
+		{ 18, 11 }, { 1, 1 }, { 35, 21 }, { 5, 17 }, { 0, 0 }, { 40, 30 }
+	};
+	int max_d = 60;
+	struct loc *grids = mem_alloc(DISTANCE_RING_MAX(max_d) * sizeof(*grids));
+	size_t i;
+	int d;
+
+	for (i = 0; i < N_ELEMENTS(centres); i++) {
+		for (d = 0; d <= max_d; d++) {
+			struct loc grid;
+			int n = distance_ring(c, centres[i], d, grids);
+			int k = 0;
+
+			require(n <= DISTANCE_RING_MAX(d));
+
+			/* Same grids, in row-major order */
+			for (grid.y = 1; grid.y < c->height - 1; grid.y++) {
+				for (grid.x = 1; grid.x < c->width - 1; grid.x++) {
+					if (distance(grid, centres[i]) != d) continue;
+					require(k < n);
+					require(loc_eq(grids[k], grid));
+					k++;
+				}
+			}
+			eq(k, n);
+		}
+	}
+	mem_free(grids);
+	ok;
+}
+
+static int test_unbounded_size(void *state) {
+	struct chunk *c = cave_new(203, 203);
+	struct loc ctr = loc(101, 101);
+	struct loc *grids = mem_alloc(DISTANCE_RING_MAX(100) * sizeof(*grids));
+	int d;
+
+	/* Rings inside the chunk are never empty and stay within the bound */
+	for (d = 1; d <= 100; d++) {
+		int n = distance_ring(c, ctr, d, grids);
+
+		require(n > 0 && n <= DISTANCE_RING_MAX(d));
+	}
+	eq(distance_ring(c, ctr, -1, grids), 0);
+	mem_free(grids);
+	cave_free(c);
+	ok;
+}
+
+const char *suite_name = "cave/ring";
+struct test tests[] = {
+	{ "same-as-scan", test_same_as_scan },
+	{ "unbounded-size", test_unbounded_size },
+	{ NULL, NULL }
+};
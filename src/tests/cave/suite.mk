@@ -1,3 +1,6 @@
 TESTPROGS += \
 	cave/find \
+	cave/nearby \
+	cave/region \
+	cave/ring \
 	cave/scatter
@@ -0,0 +1,106 @@
+/* game/event.c */
+/* Exercise the batching and counting of game events. */
+
+#include "unit-test.h"
+#include "game-event.h"
+
+static int calls[N_GAME_EVENTS];
+static game_event_type order[8];
+static int n_order;
+
+static void count_event(game_event_type type, game_event_data *data,
+		void *user)
+{
+	calls[type]++;
+	if (n_order < (int) N_ELEMENTS(order)) {
+		order[n_order++] = type;
+	}
+}
+
+int setup_tests(void **state) {
+	event_add_handler(EVENT_REFRESH, count_event, NULL);
+	event_add_handler(EVENT_INVENTORY, count_event, NULL);
+	event_add_handler(EVENT_HP, count_event, NULL);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	event_remove_all_handlers();
+	return 0;
+}
+
+static void reset_counts(void)
+{
+	memset(calls, 0, sizeof(calls));
+	n_order = 0;
+	event_reset_stats(false);
+}
+
+static int test_unbatched(void *state) {
+	reset_counts();
+	event_signal(EVENT_REFRESH);
+	event_signal(EVENT_REFRESH);
+	eq(calls[EVENT_REFRESH], 2);
+	eq(event_get_stats(EVENT_REFRESH)->signalled, 2);
+	eq(event_get_stats(EVENT_REFRESH)->dispatched, 2);
+	eq(event_get_stats(EVENT_REFRESH)->coalesced, 0);
+	ok;
+}
+
+static int test_batched(void *state) {
+	reset_counts();
+	event_batch_begin();
+	event_signal(EVENT_REFRESH);
+	event_signal(EVENT_INVENTORY);
+	event_signal(EVENT_REFRESH);
+	event_signal(EVENT_INVENTORY);
+
+	/* Events that are not redraws go straight out */
+	event_signal(EVENT_HP);
+	eq(calls[EVENT_HP], 1);
+	eq(calls[EVENT_REFRESH], 0);
+	eq(calls[EVENT_INVENTORY], 0);
+
+	/* Only the outermost batch sends */
+	event_batch_begin();
+	event_signal(EVENT_REFRESH);
+	event_batch_end();
+	eq(calls[EVENT_REFRESH], 0);
+
+	event_batch_end();
+	eq(calls[EVENT_REFRESH], 1);
+	eq(calls[EVENT_INVENTORY], 1);
+	eq(n_order, 3);
+	eq(order[0], EVENT_HP);
+	eq(order[1], EVENT_INVENTORY);
+	eq(order[2], EVENT_REFRESH);
+	eq(event_get_stats(EVENT_REFRESH)->signalled, 3);
+	eq(event_get_stats(EVENT_REFRESH)->dispatched, 1);
+	eq(event_get_stats(EVENT_REFRESH)->coalesced, 2);
+
+	/* Nothing is left over for the next batch */
+	event_batch_begin();
+	event_batch_end();
+	eq(calls[EVENT_REFRESH], 1);
+	ok;
+}
+
+static int test_no_handler(void *state) {
+	reset_counts();
+	event_batch_begin();
+	event_signal(EVENT_EQUIPMENT);
+	event_signal(EVENT_EQUIPMENT);
+	event_batch_end();
+	eq(event_get_stats(EVENT_EQUIPMENT)->signalled, 2);
+	eq(event_get_stats(EVENT_EQUIPMENT)->dispatched, 0);
+	eq(event_get_stats(EVENT_EQUIPMENT)->coalesced, 0);
+	ok;
+}
+
+const char *suite_name = "game/event";
+struct test tests[] = {
+	{ "unbatched", test_unbatched },
+	{ "batched", test_batched },
+	{ "no-handler", test_no_handler },
+	{ NULL, NULL },
+};
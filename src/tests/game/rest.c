@@ -0,0 +1,134 @@
+/* game/rest.c */
+/* Check that resting is interrupted when it should be. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "cmd-core.h"
+#include "game-event.h"
+#include "game-world.h"
+#include "init.h"
+#include "mon-make.h"
+#include "mon-predicate.h"
+#include "mon-util.h"
+#include "player-birth.h"
+#include "player-calcs.h"
+#include "player-util.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	if (!init_angband()) {
+		return 1;
+	}
+#ifdef UNIX
+	create_needed_dirs();
+#endif
+
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+/* A lit room with permanent walls, the player in the middle of the west end */
+static struct chunk *create_lit_cave(int height, int width) {
+	struct chunk *c = cave_new(height, width);
+	struct loc grid;
+
+	for (grid.y = 0; grid.y < height; ++grid.y) {
+		for (grid.x = 0; grid.x < width; ++grid.x) {
+			if (grid.y == 0 || grid.x == 0 || grid.y == height - 1
+					|| grid.x == width - 1) {
+				square_set_feat(c, grid, FEAT_PERM);
+			} else {
+				square_set_feat(c, grid, FEAT_FLOOR);
+			}
+			sqinfo_on(square(c, grid)->info, SQUARE_GLOW);
+		}
+	}
+	return c;
+}
+
+static void setup_player_cave(struct chunk *c, struct player *p) {
+	int i;
+
+	p->cave = cave_new(c->height, c->width);
+	p->cave->objects = mem_realloc(p->cave->objects, (c->obj_max + 1) *
+		sizeof(struct object*));
+	p->cave->obj_max = c->obj_max;
+	for (i = 0; i <= p->cave->obj_max; ++i) {
+		p->cave->objects[i] = NULL;
+	}
+	p->cave->depth = c->depth;
+}
+
+/* How many player turns to rest before the monster turns up */
+#define REST_BEFORE_MONSTER 30
+
+static int rest_turns;
+static int32_t monster_turn;
+static struct monster *arrival;
+
+/*
+ * Called once a player turn, before the player acts; brings a monster into
+ * view part way through the rest.
+ */
+static void monster_arrives(game_event_type type, game_event_data *data,
+		void *user)
+{
+	struct monster_group_info info = { 0, 0 };
+	struct loc grid = loc(player->grid.x + 4, player->grid.y);
+
+	if (!player_is_resting(player) || arrival) return;
+	if (++rest_turns < REST_BEFORE_MONSTER) return;
+	if (place_new_monster(cave, grid,
+			lookup_monster("Grip, Farmer Maggot's Dog"), false, false,
+			info, ORIGIN_DROP)) {
+		arrival = square_monster(cave, grid);
+		monster_turn = turn;
+	}
+}
+
+static int test_monster_stops_rest(void *state) {
+	character_dungeon = false;
+	player->depth = 1;
+	cave = create_lit_cave(11, 40);
+	cave->depth = player->depth;
+	setup_player_cave(cave, player);
+	player_place(cave, player, loc(5, cave->height / 2));
+	character_dungeon = true;
+	on_new_level();
+
+	event_add_handler(EVENT_CHECK_INTERRUPT, monster_arrives, NULL);
+	cmdq_push(CMD_REST);
+	cmd_set_arg_choice(cmdq_peek(), "choice", 1000);
+	run_game_loop();
+	event_remove_handler(EVENT_CHECK_INTERRUPT, monster_arrives, NULL);
+
+	/* The rest went on until the monster turned up, and stopped at once */
+	notnull(arrival);
+	eq(rest_turns, REST_BEFORE_MONSTER);
+	require(monster_is_visible(arrival));
+	require(!player_is_resting(player));
+	eq(turn, monster_turn);
+
+	wipe_mon_list(cave, player);
+	cave_free(player->cave);
+	player->cave = NULL;
+	cave_free(cave);
+	cave = NULL;
+	ok;
+}
+
+const char *suite_name = "game/rest";
+struct test tests[] = {
+	{ "monster stops rest", test_monster_stops_rest },
+	{ NULL, NULL }
+};
@@ -0,0 +1,296 @@
+/* game/store.c */
+/* Check that stores catch up on owed maintenance the same way whenever they
+ * are looked at, and that their state survives saving and loading. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-util.h"
+#include "obj-util.h"
+#include "player-birth.h"
+#include "savefile.h"
+#include "store.h"
+#include "z-file.h"
+
+/* Size of a block header in a savefile */
+#define BLOCK_HEAD_SIZE 28
+
+static void reset_before_load(void) {
+	play_again = true;
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	chunk_list_max = 0;
+	init_angband();
+	play_again = false;
+}
+
+int setup_tests(void **state) {
+	set_file_paths();
+	if (!init_angband()) {
+		return 1;
+	}
+#ifdef UNIX
+	create_needed_dirs();
+#endif
+
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	prepare_next_level(player);
+	on_new_level();
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	file_delete("Test2");
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+/* Start the stores afresh from a fixed seed, at birth depth */
+static void restart_stores(void)
+{
+	player->max_depth = 0;
+	store_reset();
+	store_seed = 0x1234567;
+}
+
+/* Owe the stores some days, as a return to town does */
+static void owe_days(int days, int depth)
+{
+	player->max_depth = depth;
+	daycount = days;
+	store_update();
+}
+
+static void catch_up_all(void)
+{
+	int i;
+
+	for (i = 0; i < z_info->store_max; i++) {
+		store_catch_up(&stores[i]);
+	}
+}
+
+static int stock_count(void)
+{
+	int i, n = 0;
+
+	for (i = 0; i < z_info->store_max; i++) {
+		n += stores[i].stock_num;
+	}
+	return n;
+}
+
+/* Sum up what every store has in stock */
+static uint32_t stock_hash(void)
+{
+	uint32_t h = 2166136261u;
+	int i;
+
+	for (i = 0; i < z_info->store_max; i++) {
+		const struct object *obj;
+
+		for (obj = stores[i].stock; obj; obj = obj->next) {
+			int32_t v[8];
+			size_t j;
+
+			v[0] = i;
+			v[1] = obj->kind->kidx;
+			v[2] = obj->number;
+			v[3] = obj->ego ? (int32_t)obj->ego->eidx : -1;
+			v[4] = obj->to_h;
+			v[5] = obj->to_d;
+			v[6] = obj->to_a;
+			v[7] = obj->pval;
+			for (j = 0; j < N_ELEMENTS(v); j++) {
+				h = (h ^ (uint32_t)v[j]) * 16777619u;
+			}
+		}
+	}
+	return h;
+}
+
+static int test_catch_up(void *state) {
+	uint32_t at_once, in_steps, one_depth;
+
+	/* Catch up on everything at the end, at a depth not owed */
+	restart_stores();
+	owe_days(3, 10);
+	owe_days(2, 40);
+	eq(store_owed_num, 3);
+	player->max_depth = 1;
+	catch_up_all();
+	require(stock_count() > 0);
+	eq(store_owed_num, 0);
+	at_once = stock_hash();
+
+	/* Catch up after each return to town instead */
+	restart_stores();
+	catch_up_all();
+	owe_days(3, 10);
+	catch_up_all();
+	owe_days(2, 40);
+	player->max_depth = 60;
+	catch_up_all();
+	in_steps = stock_hash();
+	eq(in_steps, at_once);
+
+	/* The depth the days were owed at is what counts */
+	restart_stores();
+	owe_days(5, 10);
+	eq(store_owed_num, 2);
+	catch_up_all();
+	one_depth = stock_hash();
+	require(one_depth != at_once);
+	ok;
+}
+
+static int test_save_load(void *state) {
+	uint32_t before;
+
+	restart_stores();
+	owe_days(3, 10);
+	owe_days(2, 40);
+	eq(savefile_save("Test2"), true);
+	catch_up_all();
+	before = stock_hash();
+
+	/* The owed days and their depths come back with the save */
+	reset_before_load();
+	eq(savefile_load("Test2", false), true);
+	eq(stock_count(), 0);
+	eq(store_owed_num, 3);
+	eq(store_owed[2].last_day, store_day);
+	eq(store_owed[2].depth, 40);
+	player->max_depth = 1;
+	catch_up_all();
+	eq(stock_hash(), before);
+	ok;
+}
+
+static uint16_t get_u16(const uint8_t *p)
+{
+	return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+		((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+	p[0] = v & 0xFF;
+	p[1] = (v >> 8) & 0xFF;
+	p[2] = (v >> 16) & 0xFF;
+	p[3] = (v >> 24) & 0xFF;
+}
+
+/*
+ * Rewrite the stores block of a savefile the way version 1 wrote it; only
+ * stores with nothing in stock can be rewritten.
+ */
+static bool write_old_stores_block(const char *path)
+{
+	uint8_t *data = mem_alloc(1 << 20), *old;
+	ang_file *f = file_open(path, MODE_READ, FTYPE_RAW);
+	int len, pos = 8, old_len = 0;
+	bool done = false;
+
+	if (!f) return false;
+	len = file_read(f, (char *)data, 1 << 20);
+	file_close(f);
+	if (len < 8 || len == 1 << 20) {
+		mem_free(data);
+		return false;
+	}
+	old = mem_zalloc(len);
+	memcpy(old, data, pos);
+	old_len = pos;
+	while (pos + BLOCK_HEAD_SIZE <= len) {
+		uint8_t *head = data + pos, *body = head + BLOCK_HEAD_SIZE;
+		uint32_t size = get_u32(head + 20), padded = (size + 3) & ~3u;
+
+		if (streq((char *)head, "stores") && get_u32(head + 16) == 2) {
+			uint16_t n = get_u16(body), owed = get_u16(body + 10), i;
+			const uint8_t *s = body + 12 + 6 * owed;
+			uint8_t *out = old + old_len + BLOCK_HEAD_SIZE;
+
+			memcpy(old + old_len, head, BLOCK_HEAD_SIZE);
+			memcpy(out, body, 2);
+			for (i = 0; i < n; i++) {
+				if (s[6 * i + 1]) break;
+				out[2 + 2 * i] = s[6 * i];
+				out[3 + 2 * i] = 0;
+			}
+			if (i < n) break;
+			put_u32(old + old_len + 16, 1);
+			put_u32(old + old_len + 20, 2 + 2 * n);
+			old_len += BLOCK_HEAD_SIZE + ((2 + 2 * n + 3) & ~3u);
+			done = true;
+		} else {
+			memcpy(old + old_len, head, BLOCK_HEAD_SIZE + padded);
+			old_len += BLOCK_HEAD_SIZE + padded;
+		}
+		pos += BLOCK_HEAD_SIZE + padded;
+	}
+
+	if (done) {
+		f = file_open(path, MODE_WRITE, FTYPE_RAW);
+		done = f && file_write(f, (char *)old, old_len);
+		if (f) file_close(f);
+	}
+	mem_free(old);
+	mem_free(data);
+	return done;
+}
+
+static int test_load_old(void *state) {
+	uint8_t owner[64];
+	int i;
+
+	require(z_info->store_max <= (int)N_ELEMENTS(owner));
+	restart_stores();
+	owe_days(3, 10);
+	for (i = 0; i < z_info->store_max; i++) {
+		owner[i] = stores[i].owner->oidx;
+	}
+	eq(savefile_save("Test2"), true);
+	require(write_old_stores_block("Test2"));
+
+	/* Stores from before maintenance was owed are up to date */
+	reset_before_load();
+	eq(savefile_load("Test2", false), true);
+	eq(store_day, 0);
+	eq(store_owed_num, 0);
+	for (i = 0; i < z_info->store_max; i++) {
+		eq(stores[i].maint_day, store_day);
+		eq(stores[i].owner->oidx, owner[i]);
+	}
+	catch_up_all();
+	eq(stock_count(), 0);
+
+	/* Days owed after loading are kept as usual */
+	owe_days(2, 20);
+	eq(store_owed_num, 1);
+	catch_up_all();
+	require(stock_count() > 0);
+	eq(store_owed_num, 0);
+	ok;
+}
+
+const char *suite_name = "game/store";
+struct test tests[] = {
+	{ "catch up", test_catch_up },
+	{ "save and load", test_save_load },
+	{ "load old stores block", test_load_old },
+	{ NULL, NULL }
+};
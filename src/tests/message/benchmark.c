@@ -0,0 +1,199 @@
+/* message/benchmark.c */
+/*
+ * Compare the message log against a copy of the linked list it replaced,
+ * first for the same contents and then for speed.  The timings are printed
+ * for information; only the contents are tested.
+ */
+
+#include "unit-test.h"
+#include "unit-test-data.h"
+
+#include "message.h"
+#include "z-form.h"
+#include "z-util.h"
+#include "z-virt.h"
+#include <time.h>
+
+/* Enough messages to wrap the log many times over */
+#define BENCH_ADDS 200000
+
+/* Number of full passes over the log by age */
+#define BENCH_PASSES 20
+
+/*
+ * The old list implementation, kept only for comparison
+ */
+struct list_message {
+	char *str;
+	struct list_message *newer;
+	struct list_message *older;
+	uint16_t type;
+	uint16_t count;
+};
+
+struct list_log {
+	struct list_message *head;
+	struct list_message *tail;
+	uint32_t count;
+	uint32_t max;
+};
+
+static void list_add(struct list_log *l, const char *str, uint16_t type)
+{
+	struct list_message *m;
+
+	if (l->head && l->head->type == type && streq(l->head->str, str) &&
+			l->head->count != (uint16_t)-1) {
+		l->head->count++;
+		return;
+	}
+
+	m = mem_zalloc(sizeof(*m));
+	m->str = string_make(str);
+	m->type = type;
+	m->count = 1;
+	m->older = l->head;
+	if (l->head)
+		l->head->newer = m;
+	l->head = m;
+	l->count++;
+	if (!l->tail)
+		l->tail = m;
+
+	if (l->count > l->max) {
+		struct list_message *old_tail = l->tail;
+
+		l->tail = old_tail->newer;
+		l->tail->older = NULL;
+		string_free(old_tail->str);
+		mem_free(old_tail);
+		l->count--;
+	}
+}
+
+static struct list_message *list_get(struct list_log *l, uint16_t age)
+{
+	struct list_message *m = l->head;
+
+	while (m && age) {
+		age--;
+		m = m->older;
+	}
+
+	return m;
+}
+
+static void list_free(struct list_log *l)
+{
+	struct list_message *m = l->head;
+
+	while (m) {
+		struct list_message *next = m->older;
+
+		string_free(m->str);
+		mem_free(m);
+		m = next;
+	}
+	l->head = l->tail = NULL;
+	l->count = 0;
+}
+
+/*
+ * Make up the i'th message; every so often repeat the last one so that
+ * stacking gets exercised.
+ */
+static void bench_text(int i, char *buf, size_t len)
+{
+	if (i % 7 == 6) i--;
+	strnfmt(buf, len, "The orc number %d hits you (%d).", i % 1000, i);
+}
+
+int setup_tests(void **state) {
+	messages_init();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	messages_free();
+	return 0;
+}
+
+static int test_same(void *state) {
+	struct list_log l = { NULL, NULL, 0, MESSAGE_MAX_DEFAULT };
+	char buf[80];
+	uint16_t age;
+	int i;
+
+	messages_free();
+	messages_init();
+	for (i = 0; i < 3 * MESSAGE_MAX_DEFAULT + 17; i++) {
+		bench_text(i, buf, sizeof(buf));
+		message_add(buf, i % 5);
+		list_add(&l, buf, i % 5);
+	}
+
+	eq(messages_num(), l.count);
+	for (age = 0; age < l.count; age++) {
+		struct list_message *m = list_get(&l, age);
+
+		require(streq(message_str(age), m->str));
+		eq(message_type(age), m->type);
+		eq(message_count(age), m->count);
+	}
+	list_free(&l);
+	ok;
+}
+
+static int test_speed(void *state) {
+	struct list_log l = { NULL, NULL, 0, MESSAGE_MAX_DEFAULT };
+	char buf[80];
+	clock_t start;
+	double t_list, t_ring;
+	size_t sum_list = 0, sum_ring = 0;
+	uint16_t age;
+	int i, pass;
+
+	messages_free();
+	messages_init();
+
+	/* The list */
+	start = clock();
+	for (i = 0; i < BENCH_ADDS; i++) {
+		bench_text(i, buf, sizeof(buf));
+		list_add(&l, buf, MSG_GENERIC);
+	}
+	for (pass = 0; pass < BENCH_PASSES; pass++) {
+		for (age = 0; age < l.count; age++) {
+			sum_list += strlen(list_get(&l, age)->str);
+		}
+	}
+	t_list = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	/* The ring */
+	start = clock();
+	for (i = 0; i < BENCH_ADDS; i++) {
+		bench_text(i, buf, sizeof(buf));
+		message_add(buf, MSG_GENERIC);
+	}
+	for (pass = 0; pass < BENCH_PASSES; pass++) {
+		for (age = 0; age < messages_num(); age++) {
+			sum_ring += strlen(message_str(age));
+		}
+	}
+	t_ring = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	if (verbose) {
+		printf("message log: list %.3fs, ring %.3fs\n", t_list, t_ring);
+	}
+
+	eq(sum_list, sum_ring);
+	list_free(&l);
+	ok;
+}
+
+const char *suite_name = "message/benchmark";
+struct test tests[] = {
+	{ "same", test_same },
+	{ "speed", test_speed },
+	{ NULL, NULL },
+};
@@ -254,6 +254,43 @@ static int test_fill(void *state) {
 	ok;
 }
 
+static int test_set_max(void *state)
+{
+	char buf[16];
+	uint16_t n;
+	int i;
+
+	messages_free();
+	messages_init();
+
+	for (i = 0; i < 10; i++) {
+		strnfmt(buf, sizeof(buf), "%d", i);
+		message_add(buf, MSG_GENERIC);
+	}
+
+	/* Shrinking keeps the newest messages */
+	messages_set_max(4);
+	n = messages_num();
+	eq(n, 4);
+	require(streq(message_str(0), "9"));
+	require(streq(message_str(3), "6"));
+	require(streq(message_str(4), ""));
+
+	/* Growing keeps them all, and new ones push out the oldest later */
+	messages_set_max(6);
+	eq(messages_num(), 4);
+	for (i = 10; i < 13; i++) {
+		strnfmt(buf, sizeof(buf), "%d", i);
+		message_add(buf, MSG_GENERIC);
+	}
+	n = messages_num();
+	eq(n, 6);
+	require(streq(message_str(0), "12"));
+	require(streq(message_str(5), "7"));
+
+	ok;
+}
+
 static int test_many_repeat(void *state)
 {
 	int i = 0;
@@ -662,6 +699,7 @@ struct test tests[] = {
 	{ "empty", test_empty },
 	{ "add", test_add },
 	{ "fill", test_fill },
+	{ "set_max", test_set_max },
 	{ "many_repeat", test_many_repeat },
 	{ "color", test_color },
 	{ "format", test_msg },
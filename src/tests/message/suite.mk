@@ -1 +1,2 @@
 TESTPROGS += message/message
+TESTPROGS += message/benchmark
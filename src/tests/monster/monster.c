@@ -6,7 +6,9 @@
  *             26 Apr 2011
  */
 
+#include "mon-list.h"
 #include "mon-make.h"
+#include "mon-predicate.h"
 #include "mon-util.h"
 #include "player-birth.h"
 #include "test-utils.h"
@@ -128,9 +130,85 @@ static int test_nearby_kin(void *state) {
 	ok;
 }
 
+static int test_compact(void *state) {
+	struct chunk *c = t_build_arena(20, 20);
+	struct monster *mon;
+	int i;
+
+	player_make_simple(NULL, NULL, "Tester");
+
+	/* Two wolves far away, two close by, and a far away unique */
+	t_add_monster(c, loc(2, 2), "wolf")->cdis = 90;
+	t_add_monster(c, loc(3, 2), "wolf")->cdis = 2;
+	t_add_monster(c, loc(4, 2), "wolf")->cdis = 80;
+	t_add_monster(c, loc(5, 2), "wolf")->cdis = 1;
+	t_add_monster(c, loc(6, 2), "Grip, Farmer Maggot's Dog")->cdis = 95;
+	eq(cave_monster_max(c), 6);
+
+	/* The far away wolves go first, and the list is closed up */
+	compact_monsters(c, 2);
+	eq(cave_monster_count(c), 3);
+	eq(cave_monster_max(c), 4);
+	null(square_monster(c, loc(2, 2)));
+	null(square_monster(c, loc(4, 2)));
+	for (i = 1; i < cave_monster_max(c); i++) {
+		mon = cave_monster(c, i);
+		notnull(mon->race);
+		eq(mon->midx, i);
+		ptreq(square_monster(c, mon->grid), mon);
+	}
+
+	/* Then the close wolves, before the unique */
+	compact_monsters(c, 2);
+	eq(cave_monster_count(c), 1);
+	mon = cave_monster(c, 1);
+	require(monster_is_unique(mon));
+
+	wipe_mon_list(c, player);
+	cave_free(c);
+
+	ok;
+}
+
+/* A mimic shows up in a kept monster list once it is unmasked */
+static int test_unmask_listed(void *state) {
+	struct chunk *c = t_build_arena(20, 20);
+	struct chunk *old_cave = cave;
+	struct monster *mimic;
+	monster_list_t *list;
+
+	cave = c;
+	mimic = t_add_monster(c, loc(5, 5), "lurker");
+	require(monster_is_camouflaged(mimic));
+	mflag_on(mimic->mflag, MFLAG_VISIBLE);
+
+	list = monster_list_new();
+	monster_list_reset(list);
+	monster_list_collect(list);
+	eq(list->distinct_entries, 0);
+	require(!monster_list_needs_update(list));
+
+	become_aware(c, mimic);
+	require(!monster_is_camouflaged(mimic));
+	require(monster_list_needs_update(list));
+	monster_list_reset(list);
+	monster_list_collect(list);
+	eq(list->distinct_entries, 1);
+	ptreq(list->entries[0].race, mimic->race);
+
+	monster_list_free(list);
+	wipe_mon_list(c, player);
+	cave = old_cave;
+	cave_free(c);
+
+	ok;
+}
+
 const char *suite_name = "monster/monster";
 struct test tests[] = {
 	{ "match_monster_bases", test_match_monster_bases },
+	{ "unmask_listed", test_unmask_listed },
 	{ "nearby_kin", test_nearby_kin },
+	{ "compact", test_compact },
 	{ NULL, NULL }
 };
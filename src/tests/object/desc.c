@@ -0,0 +1,137 @@
+/* object/desc */
+/*
+ * Check that cached object descriptions follow changes to the object and to
+ * the player's knowledge.
+ */
+
+#include "unit-test.h"
+#include "unit-test-data.h"
+
+#include "obj-desc.h"
+#include "obj-make.h"
+#include "obj-pile.h"
+#include "obj-util.h"
+#include "object.h"
+#include "z-quark.h"
+
+static const uint32_t modes[] = {
+	ODESC_PREFIX | ODESC_FULL,
+	ODESC_BASE,
+	ODESC_PREFIX | ODESC_FULL | ODESC_STORE,
+	ODESC_FULL | ODESC_TERSE,
+	ODESC_PREFIX | ODESC_FULL | ODESC_SPOIL,
+	ODESC_PREFIX | ODESC_FULL | ODESC_CAPITAL | ODESC_PLURAL
+};
+
+int setup_tests(void **state) {
+	player = &test_player;
+	z_info = mem_zalloc(sizeof(struct angband_constants));
+	quarks_init();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	quarks_free();
+	mem_free(z_info);
+	return 0;
+}
+
+/*
+ * Describe the object in every mode, first as it comes and then with the
+ * cache emptied; the two must agree.
+ */
+static bool same_as_fresh(const struct object *obj)
+{
+	char cached[80], fresh[80];
+	size_t i;
+
+	for (i = 0; i < N_ELEMENTS(modes); i++) {
+		size_t n1 = object_desc(cached, sizeof(cached), obj, modes[i],
+			player);
+		size_t n2;
+
+		object_desc_forget();
+		n2 = object_desc(fresh, sizeof(fresh), obj, modes[i], player);
+		if (n1 != n2 || !streq(cached, fresh)) {
+			if (verbose) {
+				printf("'%s' but should be '%s'\n", cached,
+					fresh);
+			}
+			return false;
+		}
+	}
+	return true;
+}
+
+static int test_changes(void *state) {
+	struct object obj = OBJECT_NULL, known = OBJECT_NULL;
+	char buf[80];
+	size_t n;
+
+	object_prep(&obj, &test_longsword, 1, AVERAGE);
+	obj.to_h = 3;
+	obj.to_d = 4;
+	object_copy(&known, &obj);
+	known.to_h = 0;
+	known.to_d = 0;
+	obj.known = &known;
+	require(same_as_fresh(&obj));
+
+	/* The stack grows */
+	obj.number = 3;
+	require(same_as_fresh(&obj));
+
+	/* The player learns the to-hit rune, then assesses the object */
+	player->obj_k->to_h = 1;
+	require(same_as_fresh(&obj));
+	known.to_h = obj.to_h;
+	known.notice |= OBJ_NOTICE_ASSESSED;
+	obj.notice |= OBJ_NOTICE_ASSESSED;
+	require(same_as_fresh(&obj));
+	player->obj_k->to_d = 1;
+	known.to_d = obj.to_d;
+	require(same_as_fresh(&obj));
+
+	/* It gets inscribed */
+	obj.note = quark_add("@w1");
+	require(same_as_fresh(&obj));
+	object_desc(buf, sizeof(buf), &obj, ODESC_PREFIX | ODESC_FULL, player);
+	require(strstr(buf, "{@w1}") != NULL);
+
+	/* A short buffer gets the description cut short, as before */
+	n = object_desc(buf, 20, &obj, ODESC_PREFIX | ODESC_FULL, player);
+	eq(strlen(buf), 19);
+	object_desc_forget();
+	eq(object_desc(buf, 20, &obj, ODESC_PREFIX | ODESC_FULL, player), n);
+
+	/* The player forgets, as when a new character starts */
+	player->obj_k->to_h = 0;
+	player->obj_k->to_d = 0;
+	require(same_as_fresh(&obj));
+
+	/* A light burns down */
+	object_wipe(&obj);
+	object_wipe(&known);
+	object_prep(&obj, &test_torch, 1, AVERAGE);
+	obj.timeout = 100;
+	object_copy(&known, &obj);
+	obj.known = &known;
+	require(same_as_fresh(&obj));
+	object_desc(buf, sizeof(buf), &obj, ODESC_FULL, player);
+	obj.timeout--;
+	known.timeout--;
+	require(same_as_fresh(&obj));
+	object_desc(buf, sizeof(buf), &obj, ODESC_FULL, player);
+	require(strstr(buf, "(99 turns)") != NULL);
+
+	obj.known = NULL;
+	object_wipe(&known);
+	object_wipe(&obj);
+	ok;
+}
+
+const char *suite_name = "object/desc";
+struct test tests[] = {
+	{ "changes", test_changes },
+	{ NULL, NULL },
+};
@@ -5,6 +5,7 @@
 #include "unit-test.h"
 #include "unit-test-data.h"
 
+#include "cave.h"
 #include "object.h"
 #include "obj-pile.h"
 
@@ -91,8 +92,67 @@ static int test_obj_piles(void *state) {
 	ok;
 }
 
+/* Testing slot management for the object list of a chunk */
+static int test_obj_list(void *state) {
+	struct object *objs[300];
+	struct chunk *c;
+	int i, max;
+
+	z_info = &test_z_info;
+	c = cave_new(11, 9);
+
+	/* Fill the list, growing it on the way */
+	for (i = 0; i < 300; i++) {
+		objs[i] = object_new();
+		list_object(c, objs[i]);
+		require(objs[i]->oidx > 0);
+		ptreq(c->objects[objs[i]->oidx], objs[i]);
+	}
+	for (i = 1; i < 300; i++) {
+		eq(objs[i]->oidx, objs[i - 1]->oidx + 1);
+	}
+	max = c->obj_max;
+
+	/* Listing again changes nothing */
+	list_object(c, objs[10]);
+	eq(objs[10]->oidx, 11);
+	eq(c->obj_max, max);
+
+	/* Holes get filled before the list grows */
+	delist_object(c, objs[20]);
+	delist_object(c, objs[200]);
+	eq(objs[20]->oidx, 0);
+	null(c->objects[21]);
+	list_object(c, objs[200]);
+	list_object(c, objs[20]);
+	eq(objs[200]->oidx, 201);
+	eq(objs[20]->oidx, 21);
+	eq(c->obj_max, max);
+
+	/* Holes made behind the list's back are found too */
+	c->objects[objs[50]->oidx] = NULL;
+	objs[50]->oidx = 0;
+	for (i = 301; i < max; i++) {
+		c->objects[i] = object_new();
+		c->objects[i]->oidx = i;
+	}
+	list_object(c, objs[50]);
+	eq(objs[50]->oidx, 51);
+	eq(c->obj_max, max);
+
+	for (i = 1; i < c->obj_max; i++) {
+		if (c->objects[i]) {
+			object_free(c->objects[i]);
+			c->objects[i] = NULL;
+		}
+	}
+	cave_free(c);
+	ok;
+}
+
 const char *suite_name = "object/pile";
 struct test tests[] = {
 	{ "pile checking", test_obj_piles },
+	{ "object list", test_obj_list },
 	{ NULL, NULL }
 };
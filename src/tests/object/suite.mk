@@ -1,6 +1,7 @@
 TESTPROGS += \
 	object/alloc \
 	object/attack \
+	object/desc \
 	object/info \
 	object/pile \
 	object/slays \
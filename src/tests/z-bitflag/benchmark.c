@@ -0,0 +1,234 @@
+/* z-bitflag/benchmark.c */
+/*
+ * Check the word-at-a-time bitfield operations against simple byte-at-a-time
+ * versions, then time the two.  The timings are printed for information;
+ * only the results are tested.
+ */
+
+#include "unit-test.h"
+
+#include "z-bitflag.h"
+#include "z-rand.h"
+#include <time.h>
+
+/* Largest flag set to try, in bytes; covers every set the game uses */
+#define BENCH_MAX_SIZE 40
+
+/* Number of random pairs of flag sets checked for each size */
+#define BENCH_TRIALS 200
+
+/* Number of passes for the timings */
+#define BENCH_PASSES 200000
+
+/*
+ * The byte-at-a-time versions, kept only for comparison
+ */
+static int byte_next(const bitflag *flags, size_t size, int flag)
+{
+	int f;
+
+	for (f = MAX(flag, FLAG_START); f < FLAG_MAX(size); f++)
+		if (flags[FLAG_OFFSET(f)] & FLAG_BINARY(f)) return f;
+	return FLAG_END;
+}
+
+static int byte_count(const bitflag *flags, size_t size)
+{
+	size_t i, j;
+	int count = 0;
+
+	for (i = 0; i < size; i++)
+		for (j = 0; j < FLAG_WIDTH; j++)
+			if (flags[i] & (1 << j)) count++;
+	return count;
+}
+
+static bool byte_is_inter(const bitflag *f1, const bitflag *f2, size_t size)
+{
+	size_t i;
+
+	for (i = 0; i < size; i++)
+		if (f1[i] & f2[i]) return true;
+	return false;
+}
+
+static bool byte_is_subset(const bitflag *f1, const bitflag *f2, size_t size)
+{
+	size_t i;
+
+	for (i = 0; i < size; i++)
+		if (~f1[i] & f2[i]) return false;
+	return true;
+}
+
+static bool byte_is_empty(const bitflag *flags, size_t size)
+{
+	size_t i;
+
+	for (i = 0; i < size; i++)
+		if (flags[i]) return false;
+	return true;
+}
+
+static bool byte_union(bitflag *f1, const bitflag *f2, size_t size)
+{
+	size_t i;
+	bool delta = false;
+
+	for (i = 0; i < size; i++) {
+		if (~f1[i] & f2[i]) delta = true;
+		f1[i] |= f2[i];
+	}
+	return delta;
+}
+
+/*
+ * Fill a flag set with a mix of empty, full and random bytes so that the
+ * word skipping in the new versions gets exercised.
+ */
+static void bench_fill(bitflag *flags, size_t size)
+{
+	size_t i;
+	int style = randint0(3);
+
+	for (i = 0; i < size; i++) {
+		if (style == 0) {
+			flags[i] = one_in_(8) ? randint0(256) : 0;
+		} else if (style == 1) {
+			flags[i] = one_in_(8) ? randint0(256) : 255;
+		} else {
+			flags[i] = randint0(256);
+		}
+	}
+}
+
+NOSETUP
+NOTEARDOWN
+
+static int test_same(void *state) {
+	bitflag f1[BENCH_MAX_SIZE], f2[BENCH_MAX_SIZE];
+	bitflag g1[BENCH_MAX_SIZE], g2[BENCH_MAX_SIZE];
+	size_t size;
+	int trial;
+
+	Rand_init();
+	for (size = 1; size <= BENCH_MAX_SIZE; size++) {
+		for (trial = 0; trial < BENCH_TRIALS; trial++) {
+			int f, g;
+
+			bench_fill(f1, size);
+			bench_fill(f2, size);
+			if (one_in_(4)) memcpy(f2, f1, size);
+
+			/* Queries */
+			eq(flag_count(f1, size), byte_count(f1, size));
+			eq(flag_is_empty(f1, size), byte_is_empty(f1, size));
+			eq(flag_is_inter(f1, f2, size),
+				byte_is_inter(f1, f2, size));
+			eq(flag_is_subset(f1, f2, size),
+				byte_is_subset(f1, f2, size));
+			for (f = FLAG_START; f <= FLAG_MAX(size); f++) {
+				eq(flag_next(f1, size, f), byte_next(f1, size, f));
+			}
+			eq(flag_next(f1, size, FLAG_END),
+				byte_next(f1, size, FLAG_END));
+
+			/* Iterating visits every flag that is on */
+			g = 0;
+			for (f = flag_next(f1, size, FLAG_START); f != FLAG_END;
+					f = flag_next(f1, size, f + 1)) {
+				require(flag_has(f1, size, f));
+				g++;
+			}
+			eq(g, byte_count(f1, size));
+
+			/* Updates */
+			memcpy(g1, f1, size);
+			memcpy(g2, f1, size);
+			eq(flag_union(g1, f2, size), byte_union(g2, f2, size));
+			require(!memcmp(g1, g2, size));
+
+			memcpy(g1, f1, size);
+			flag_negate(g1, size);
+			for (f = 0; f < (int) size; f++) {
+				eq(g1[f], (bitflag) ~f1[f]);
+			}
+			eq(flag_is_full(g1, size), byte_is_empty(f1, size));
+
+			memcpy(g1, f1, size);
+			memcpy(g2, f1, size);
+			eq(flag_inter(g1, f2, size), memcmp(f1, f2, size) != 0);
+			for (f = 0; f < (int) size; f++) {
+				g2[f] &= f2[f];
+			}
+			require(!memcmp(g1, g2, size));
+
+			memcpy(g1, f1, size);
+			memcpy(g2, f1, size);
+			eq(flag_diff(g1, f2, size), byte_is_inter(f1, f2, size));
+			for (f = 0; f < (int) size; f++) {
+				g2[f] &= ~f2[f];
+			}
+			require(!memcmp(g1, g2, size));
+		}
+	}
+	ok;
+}
+
+static int test_speed(void *state) {
+	bitflag f1[BENCH_MAX_SIZE], f2[BENCH_MAX_SIZE];
+	clock_t start;
+	double t_byte, t_word;
+	long sum_byte = 0, sum_word = 0;
+	int pass;
+
+	Rand_init();
+	bench_fill(f1, BENCH_MAX_SIZE);
+	bench_fill(f2, BENCH_MAX_SIZE);
+
+	/* Byte at a time */
+	start = clock();
+	for (pass = 0; pass < BENCH_PASSES; pass++) {
+		size_t size = 1 + pass % BENCH_MAX_SIZE;
+		int f;
+
+		sum_byte += byte_count(f1, size);
+		sum_byte += byte_is_inter(f1, f2, size);
+		sum_byte += byte_is_subset(f1, f2, size);
+		for (f = byte_next(f1, size, FLAG_START); f != FLAG_END;
+				f = byte_next(f1, size, f + 1)) {
+			sum_byte += f;
+		}
+	}
+	t_byte = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	/* Word at a time */
+	start = clock();
+	for (pass = 0; pass < BENCH_PASSES; pass++) {
+		size_t size = 1 + pass % BENCH_MAX_SIZE;
+		int f;
+
+		sum_word += flag_count(f1, size);
+		sum_word += flag_is_inter(f1, f2, size);
+		sum_word += flag_is_subset(f1, f2, size);
+		for (f = flag_next(f1, size, FLAG_START); f != FLAG_END;
+				f = flag_next(f1, size, f + 1)) {
+			sum_word += f;
+		}
+	}
+	t_word = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	if (verbose) {
+		printf("bitflags: byte %.3fs, word %.3fs\n", t_byte, t_word);
+	}
+
+	eq(sum_byte, sum_word);
+	ok;
+}
+
+const char *suite_name = "z-bitflag/benchmark";
+struct test tests[] = {
+	{ "same", test_same },
+	{ "speed", test_speed },
+	{ NULL, NULL },
+};
@@ -0,0 +1 @@
+TESTPROGS += z-bitflag/benchmark
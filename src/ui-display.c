@@ -1357,79 +1357,40 @@ static void trace_map_updates(game_event_type type, game_event_data *data,
 
 /**
  * Update either a single map grid or a whole map
+ *
+ * Changes are only noted as they come in; they're drawn in one go by
+ * map_redraw_dirty() at the end of the current batch of updates (EVENT_END),
+ * on refresh, or when something like a message or a projection needs the map
+ * to be current.
  */
 static void update_maps(game_event_type type, game_event_data *data, void *user)
 {
 	term *t = user;
 
-	/* This signals a whole-map redraw. */
-	if (data->point.x == -1 && data->point.y == -1)
-		prt_map();
-
-	/* Single point to be redrawn */
-	else {
-		struct grid_data g;
-		int a, ta;
-		wchar_t c, tc;
-
-		int ky, kx;
-		int vy, vx;
-		int clipy;
-
-		/* Location relative to panel */
-		ky = data->point.y - t->offset_y;
-		kx = data->point.x - t->offset_x;
-
-		if (t == angband_term[0]) {
-			/* Verify location */
-			if ((ky < 0) || (ky >= SCREEN_HGT)) return;
-			if ((kx < 0) || (kx >= SCREEN_WID)) return;
-
-			/* Location in window */
-			vy = tile_height * ky + ROW_MAP;
-			vx = tile_width * kx + COL_MAP;
-
-			/* Protect the status line against modification. */
-			clipy = ROW_MAP + SCREEN_ROWS;
-		} else {
-			/* Verify location */
-			if ((ky < 0) || (ky >= t->hgt / tile_height)) return;
-			if ((kx < 0) || (kx >= t->wid / tile_width)) return;
+	if (type == EVENT_END) {
+		map_redraw_dirty();
 
-			/* Location in window */
-			vy = tile_height * ky;
-			vx = tile_width * kx;
+		/* Refresh the main screen unless the map needs to center */
+		if (player->upkeep->update & (PU_PANEL) && OPT(player, center_player)) {
+			int hgt = SCREEN_HGT / 2;
+			int wid = SCREEN_WID / 2;
 
-			/* All the rows may be used for the map. */
-			clipy = t->hgt;
+			if (panel_should_modify(t, player->grid.y - hgt,
+					player->grid.x - wid))
+				return;
 		}
 
-
-		/* Redraw the grid spot */
-		map_info(data->point, &g);
-		grid_data_as_text(&g, &a, &c, &ta, &tc);
-		Term_queue_char(t, vx, vy, a, c, ta, tc);
-#ifdef MAP_DEBUG
-		/* Plot 'spot' updates in light green to make them visible */
-		Term_queue_char(t, vx, vy, COLOUR_L_GREEN, c, ta, tc);
-#endif
-
-		if ((tile_width > 1) || (tile_height > 1))
-			Term_big_queue_char(t, vx, vy, clipy, a, c, COLOUR_WHITE, L' ');
+		Term_fresh();
+		return;
 	}
 
-	/* Refresh the main screen unless the map needs to center */
-	if (player->upkeep->update & (PU_PANEL) && OPT(player, center_player)) {
-		int hgt = (t == angband_term[0]) ? SCREEN_HGT / 2 :
-			t->hgt / (tile_height * 2);
-		int wid = (t == angband_term[0]) ? SCREEN_WID / 2 :
-			t->wid / (tile_width * 2);
-
-		if (panel_should_modify(t, player->grid.y - hgt, player->grid.x - wid))
-			return;
-	}
+	/* This signals a whole-map redraw. */
+	if (data->point.x == -1 && data->point.y == -1)
+		map_mark_all_dirty();
 
-	Term_fresh();
+	/* Single point to be redrawn */
+	else
+		map_mark_dirty(data->point);
 }
 
 /**
@@ -1478,7 +1439,8 @@ static void do_animation(void)
 			continue;
 
 		mon->attr = attr;
-		player->upkeep->redraw |= (PR_MAP | PR_MONLIST);
+		event_signal_point(EVENT_MAP, mon->grid.x, mon->grid.y);
+		player->upkeep->redraw |= (PR_MONLIST);
 	}
 
 	flicker++;
@@ -1523,6 +1485,7 @@ void idle_update(void)
 	/* Animate and redraw if necessary */
 	do_animation();
 	redraw_stuff(player);
+	map_redraw_dirty();
 
 	/* Refresh the main screen */
 	Term_fresh();
@@ -1642,6 +1605,7 @@ static void display_explosion(game_event_type type, game_event_data *data,
 			if (player_sees_grid[i])
 				event_signal_point(EVENT_MAP, x, y);
 		}
+		map_redraw_dirty();
 
 		/* Center the cursor */
 		move_cursor_relative(centre.y, centre.x);
@@ -1685,6 +1649,7 @@ static void display_bolt(game_event_type type, game_event_data *data,
 			redraw_stuff(player);
 		Term_xtra(TERM_XTRA_DELAY, msec);
 		event_signal_point(EVENT_MAP, x, y);
+		map_redraw_dirty();
 		Term_fresh();
 		if (player->upkeep->redraw)
 			redraw_stuff(player);
@@ -1726,6 +1691,7 @@ static void display_missile(game_event_type type, game_event_data *data,
 
 		Term_xtra(TERM_XTRA_DELAY, msec);
 		event_signal_point(EVENT_MAP, x, y);
+		map_redraw_dirty();
 
 		Term_fresh();
 		if (player->upkeep->redraw) redraw_stuff(player);
@@ -2503,6 +2469,10 @@ static void refresh(game_event_type type, game_event_data *data, void *user)
 		move_cursor_relative(target.y, target.x);
 	}
 
+	/* Draw whatever changed on the map */
+	if (textui_map_is_visible())
+		map_redraw_dirty();
+
 	Term_fresh();
 }
 
@@ -2754,6 +2724,7 @@ static void ui_enter_world(game_event_type type, game_event_data *data,
 
 	/* Simplest way to keep the map up to date - will do for now */
 	event_add_handler(EVENT_MAP, update_maps, angband_term[0]);
+	event_add_handler(EVENT_END, update_maps, angband_term[0]);
 #ifdef MAP_DEBUG
 	event_add_handler(EVENT_MAP, trace_map_updates, angband_term[0]);
 #endif
@@ -2819,6 +2790,7 @@ static void ui_leave_world(game_event_type type, game_event_data *data,
 
 	/* Simplest way to keep the map up to date - will do for now */
 	event_remove_handler(EVENT_MAP, update_maps, angband_term[0]);
+	event_remove_handler(EVENT_END, update_maps, angband_term[0]);
 #ifdef MAP_DEBUG
 	event_remove_handler(EVENT_MAP, trace_map_updates, angband_term[0]);
 #endif
@@ -2862,6 +2834,9 @@ static void ui_leave_world(game_event_type type, game_event_data *data,
 	/* If we've gone into a store, we need to know how to leave */
 	event_add_handler(EVENT_LEAVE_STORE, leave_store, NULL);
 
+	/* Nothing left to redraw */
+	map_dirty_free();
+
 	/* Hack -- Increase "icky" depth */
 	screen_save_depth++;
 }
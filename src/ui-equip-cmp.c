@@ -2572,6 +2572,7 @@ static int initialize_summary(struct player *p,
 		if (stores[i].feat == FEAT_HOME) {
 			continue;
 		}
+		store_catch_up(&stores[i]);
 		apply_visitor_to_pile(stores[i].stock, &visitor);
 	}
 
@@ -2614,6 +2615,7 @@ static int initialize_summary(struct player *p,
 		if (stores[i].feat == FEAT_HOME) {
 			continue;
 		}
+		store_catch_up(&stores[i]);
 		apply_visitor_to_pile(stores[i].stock, &visitor);
 	}
 
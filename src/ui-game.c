@@ -632,10 +632,12 @@ static void pre_turn_refresh(void)
 	term *old = Term;
 	int j;
 	if (character_dungeon) {
-		/* Redraw map */
-		player->upkeep->redraw |= (PR_MAP | PR_STATE);
+		/* Redraw the parts of the map which changed */
+		player->upkeep->redraw |= (PR_STATE);
 		player->upkeep->redraw |= (PR_MONLIST | PR_ITEMLIST);
 		handle_stuff(player);
+		if (textui_map_is_visible())
+			map_redraw_dirty();
 
 		if (OPT(player, show_target) && target_sighted()) {
 			struct loc target;
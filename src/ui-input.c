@@ -505,6 +505,10 @@ void display_message(game_event_type unused, game_event_data *data, void *user)
 	if (!msg || !Term || !character_generated)
 		return;
 
+	/* Make sure the map shows whatever the message is about */
+	if (character_dungeon && textui_map_is_visible())
+		map_redraw_dirty();
+
 	/* Obtain the size */
 	(void)Term_get_size(&w, &h);
 
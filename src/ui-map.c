@@ -612,6 +612,208 @@ void print_rel(wchar_t c, uint8_t a, int y, int x)
 }
 
 
+/**
+ * ------------------------------------------------------------------------
+ * Deferred map redraws
+ * ------------------------------------------------------------------------ */
+
+/**
+ * Grids of the current level whose display may have changed since they were
+ * last drawn.  There's one bit per grid and a summary flag per row so that
+ * clean rows are skipped without looking at their bits.
+ */
+static struct {
+	struct chunk *c;
+	int height, width;
+	int row_words;
+	uint32_t *bits;
+	bool *row_dirty;
+	bool any;
+	bool all;
+} map_dirty;
+
+/**
+ * Make sure the dirty map matches the current level; if it doesn't, the whole
+ * map needs to be drawn anyway.
+ */
+static bool map_dirty_fit(void)
+{
+	if (!cave) return false;
+
+	if (map_dirty.c == cave && map_dirty.height == cave->height &&
+			map_dirty.width == cave->width)
+		return true;
+
+	mem_free(map_dirty.bits);
+	mem_free(map_dirty.row_dirty);
+	map_dirty.c = cave;
+	map_dirty.height = cave->height;
+	map_dirty.width = cave->width;
+	map_dirty.row_words = (cave->width + 31) / 32;
+	map_dirty.bits = mem_zalloc(map_dirty.height * map_dirty.row_words *
+		sizeof(uint32_t));
+	map_dirty.row_dirty = mem_zalloc(map_dirty.height * sizeof(bool));
+	map_dirty.any = true;
+	map_dirty.all = true;
+	return true;
+}
+
+/**
+ * Forget everything about pending redraws, because the map is now current.
+ */
+static void map_dirty_clear(void)
+{
+	int y;
+
+	if (!map_dirty.bits) return;
+
+	for (y = 0; y < map_dirty.height; y++) {
+		if (!map_dirty.row_dirty[y]) continue;
+		memset(map_dirty.bits + y * map_dirty.row_words, 0,
+			map_dirty.row_words * sizeof(uint32_t));
+		map_dirty.row_dirty[y] = false;
+	}
+	map_dirty.any = false;
+	map_dirty.all = false;
+}
+
+/**
+ * Note that a grid has to be redrawn the next time map_redraw_dirty() is
+ * called.
+ */
+void map_mark_dirty(struct loc grid)
+{
+	if (!map_dirty_fit()) return;
+	if (grid.y < 0 || grid.y >= map_dirty.height) return;
+	if (grid.x < 0 || grid.x >= map_dirty.width) return;
+
+	map_dirty.bits[grid.y * map_dirty.row_words + grid.x / 32] |=
+		(uint32_t)1 << (grid.x % 32);
+	map_dirty.row_dirty[grid.y] = true;
+	map_dirty.any = true;
+}
+
+/**
+ * Note that the whole map has to be redrawn the next time map_redraw_dirty()
+ * is called.
+ */
+void map_mark_all_dirty(void)
+{
+	map_dirty_fit();
+	map_dirty.any = true;
+	map_dirty.all = true;
+}
+
+/**
+ * Release the dirty map when leaving the game world.
+ */
+void map_dirty_free(void)
+{
+	mem_free(map_dirty.bits);
+	mem_free(map_dirty.row_dirty);
+	memset(&map_dirty, 0, sizeof(map_dirty));
+}
+
+/**
+ * Redraw the dirty grids of one row in a map term.
+ */
+static void map_redraw_dirty_row(term *t, int y, bool main_term, int clipy)
+{
+	const uint32_t *row = map_dirty.bits + y * map_dirty.row_words;
+	int panel_hgt = main_term ? SCREEN_HGT : t->hgt / tile_height;
+	int panel_wid = main_term ? SCREEN_WID : t->wid / tile_width;
+	int ky = y - t->offset_y;
+	int x, x_end;
+
+	if (ky < 0 || ky >= panel_hgt) return;
+
+	x = MAX(t->offset_x, 0);
+	x_end = MIN(t->offset_x + panel_wid, map_dirty.width);
+	while (x < x_end) {
+		uint32_t word = row[x / 32] >> (x % 32);
+		struct grid_data g;
+		int a, ta, vx, vy;
+		wchar_t c, tc;
+
+		/* Skip the rest of a clean word in one go */
+		if (!word) {
+			x = (x / 32 + 1) * 32;
+			continue;
+		}
+		if (!(word & 1)) {
+			x++;
+			continue;
+		}
+
+		vx = tile_width * (x - t->offset_x) + (main_term ? COL_MAP : 0);
+		vy = tile_height * ky + (main_term ? ROW_MAP : 0);
+
+		map_info(loc(x, y), &g);
+		grid_data_as_text(&g, &a, &c, &ta, &tc);
+		Term_queue_char(t, vx, vy, a, c, ta, tc);
+#ifdef MAP_DEBUG
+		/* Plot 'spot' updates in light green to make them visible */
+		Term_queue_char(t, vx, vy, COLOUR_L_GREEN, c, ta, tc);
+#endif
+
+		if ((tile_width > 1) || (tile_height > 1))
+			Term_big_queue_char(t, vx, vy, clipy, a, c, COLOUR_WHITE, L' ');
+		x++;
+	}
+}
+
+/**
+ * Draw every grid marked by map_mark_dirty() (or the whole map, if
+ * map_mark_all_dirty() was called) on the main term and the overhead
+ * subwindows, and flush the subwindows.  Flushing the main term is left to
+ * the caller.
+ *
+ * Grids are drawn row by row so that each row of the terms is touched once,
+ * however many grids in it changed.
+ */
+void map_redraw_dirty(void)
+{
+	int j, y;
+
+	if (!map_dirty.any || !map_dirty_fit()) return;
+
+	/* Redraw everything */
+	if (map_dirty.all) {
+		prt_map();
+		return;
+	}
+
+	for (j = 0; j < ANGBAND_TERM_MAX; j++) {
+		term *t = angband_term[j];
+		bool main_term = (j == 0);
+		int clipy;
+
+		if (!t) continue;
+		if (!main_term && !(window_flag[j] & PW_OVERHEAD)) continue;
+
+		/*
+		 * Protect the status line on the main term; the overhead view
+		 * can use all its rows.
+		 */
+		clipy = main_term ? ROW_MAP + SCREEN_ROWS : t->hgt;
+
+		for (y = 0; y < map_dirty.height; y++) {
+			if (map_dirty.row_dirty[y])
+				map_redraw_dirty_row(t, y, main_term, clipy);
+		}
+
+		if (!main_term) {
+			term *old = Term;
+
+			Term_activate(t);
+			Term_fresh();
+			Term_activate(old);
+		}
+	}
+
+	map_dirty_clear();
+}
+
 static void prt_map_aux(void)
 {
 	int a, ta;
@@ -714,6 +916,10 @@ void prt_map(void)
 	int ty, tx;
 	int clipy;
 
+	/* Everything is about to be drawn */
+	map_dirty_fit();
+	map_dirty_clear();
+
 	/* Redraw map sub-windows */
 	prt_map_aux();
 
@@ -350,7 +350,6 @@ void monster_list_show_subwindow(int height, int width)
 {
 	textblock *tb;
 	monster_list_t *list;
-	int i;
 
 	if (height < 1 || width < 1)
 		return;
@@ -358,16 +357,13 @@ void monster_list_show_subwindow(int height, int width)
 	tb = textblock_new();
 	list = monster_list_shared_instance();
 
-	/* Force an update if detected monsters */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		if (mflag_has(cave_monster(cave, i)->mflag, MFLAG_MARK)) {
-			list->creation_turn = -1;
-			break;
-		}
+	/* Only rebuild the list if the visible monsters may have changed */
+	if (monster_list_needs_update(list)) {
+		monster_list_reset(list);
+		monster_list_collect(list);
+	} else {
+		monster_list_refresh_attrs(list);
 	}
-
-	monster_list_reset(list);
-	monster_list_collect(list);
 	monster_list_get_glyphs(list);
 	monster_list_sort(list, monster_list_standard_compare);
 
@@ -18,6 +18,52 @@
 
 #include "z-bitflag.h"
 
+/**
+ * The bitfield operations below work a machine word at a time and finish
+ * off any odd bytes one at a time.  Words are loaded and stored with
+ * memcpy(), which compilers turn into plain (unaligned) loads and stores,
+ * since flag arrays are only byte aligned.
+ */
+typedef uint64_t flag_word;
+#define FLAG_WORD_BYTES   sizeof(flag_word)
+
+static flag_word flag_load(const bitflag *flags)
+{
+	flag_word w;
+
+	memcpy(&w, flags, sizeof(w));
+	return w;
+}
+
+static void flag_store(bitflag *flags, flag_word w)
+{
+	memcpy(flags, &w, sizeof(w));
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define flag_popcount(w)  __builtin_popcountll(w)
+#define flag_lowest(b)    __builtin_ctz(b)
+#else
+static int flag_popcount(flag_word w)
+{
+	w = w - ((w >> 1) & 0x5555555555555555ULL);
+	w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+	w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (int)((w * 0x0101010101010101ULL) >> 56);
+}
+
+static int flag_lowest(unsigned int b)
+{
+	int n = 0;
+
+	while (!(b & 1)) {
+		b >>= 1;
+		n++;
+	}
+	return n;
+}
+#endif
+
 
 /**
  * Tests if a flag is "on" in a bitflag set.
@@ -69,17 +115,26 @@ bool flag_has_dbg(const bitflag *flags, const size_t size, const int flag,
  */
 int flag_next(const bitflag *flags, const size_t size, const int flag)
 {
-	const int max_flags = FLAG_MAX(size);
-	int f, flag_offset, flag_binary;
+	int f = MAX(flag, FLAG_START);
+	size_t i;
+	unsigned int b;
 
-	for (f = flag; f < max_flags; f++) {
-		flag_offset = FLAG_OFFSET(f);
-		flag_binary = FLAG_BINARY(f);
+	if (f >= FLAG_MAX(size)) return FLAG_END;
 
-		if (flags[flag_offset] & flag_binary) return f;
+	/* The rest of the byte holding the starting flag */
+	i = FLAG_OFFSET(f);
+	b = flags[i] & (0xFFu << ((f - FLAG_START) % FLAG_WIDTH));
+
+	/* Skip empty words, then empty bytes */
+	while (!b) {
+		i++;
+		while (i + FLAG_WORD_BYTES <= size && !flag_load(flags + i))
+			i += FLAG_WORD_BYTES;
+		if (i >= size) return FLAG_END;
+		b = flags[i];
 	}
 
-	return FLAG_END;
+	return FLAG_START + (int)(i * FLAG_WIDTH) + flag_lowest(b);
 }
 
 
@@ -90,16 +145,13 @@ int flag_next(const bitflag *flags, const size_t size, const int flag)
  */
 int flag_count(const bitflag *flags, const size_t size)
 {
-	size_t i, j;
+	size_t i = 0;
 	int count = 0;
 
-	for (i = 0; i < size; i++) {
-		for (j = 1; j <= FLAG_WIDTH; j++) {
-			if (flags[i] & FLAG_BINARY(j)) {
-				count++;
-			}
-		}
-	}
+	for (; i + FLAG_WORD_BYTES <= size; i += FLAG_WORD_BYTES)
+		count += flag_popcount(flag_load(flags + i));
+	for (; i < size; i++)
+		count += flag_popcount(flags[i]);
 
 	return count;
 }
@@ -113,9 +165,11 @@ int flag_count(const bitflag *flags, const size_t size)
  */
 bool flag_is_empty(const bitflag *flags, const size_t size)
 {
-	size_t i;
+	size_t i = 0;
 
-	for (i = 0; i < size; i++)
+	for (; i + FLAG_WORD_BYTES <= size; i += FLAG_WORD_BYTES)
+		if (flag_load(flags + i)) return false;
+	for (; i < size; i++)
 		if (flags[i] > 0) return false;
 
 	return true;
@@ -130,9 +184,11 @@ bool flag_is_empty(const bitflag *flags, const size_t size)
  */
 bool flag_is_full(const bitflag *flags, const size_t size)
 {
-	size_t i;
+	size_t i = 0;
 
-	for (i = 0; i < size; i++)
+	for (; i + FLAG_WORD_BYTES <= size; i += FLAG_WORD_BYTES)
+		if (flag_load(flags + i) != (flag_word) -1) return false;
+	for (; i < size; i++)
 		if (flags[i] != (bitflag) -1) return false;
 
 	return true;
@@ -148,9 +204,11 @@ bool flag_is_full(const bitflag *flags, const size_t size)
 bool flag_is_inter(const bitflag *flags1, const bitflag *flags2,
 				   const size_t size)
 {
-	size_t i;
+	size_t i = 0;
 
-	for (i = 0; i < size; i++)
+	for (; i + FLAG_WORD_BYTES <= size; i += FLAG_WORD_BYTES)
+		if (flag_load(flags1 + i) & flag_load(flags2 + i)) return true;
+	for (; i < size; i++)
 		if (flags1[i] & flags2[i]) return true;
 
 	return false;
@@ -166,9 +224,11 @@ bool flag_is_inter(const bitflag *flags1, const bitflag *flags2,
 bool flag_is_subset(const bitflag *flags1, const bitflag *flags2,
 					const size_t size)
 {
-	size_t i;
+	size_t i = 0;
 
-	for (i = 0; i < size; i++)
+	for (; i + FLAG_WORD_BYTES <= size; i += FLAG_WORD_BYTES)
+		if (~flag_load(flags1 + i) & flag_load(flags2 + i)) return false;
+	for (; i < size; i++)
 		if (~flags1[i] & flags2[i]) return false;
 
 	return true;
@@ -280,9 +340,11 @@ void flag_setall(bitflag *flags, const size_t size)
  */
 void flag_negate(bitflag *flags, const size_t size)
 {
-	size_t i;
-	
-	for (i = 0; i < size; i++)
+	size_t i = 0;
+
+	for (; i + FLAG_WORD_BYTES <= size; i += FLAG_WORD_BYTES)
+		flag_store(flags + i, ~flag_load(flags + i));
+	for (; i < size; i++)
 		flags[i] = ~flags[i];
 }
 
@@ -308,17 +370,23 @@ void flag_copy(bitflag *flags1, const bitflag *flags2, const size_t size)
  */
 bool flag_union(bitflag *flags1, const bitflag *flags2, const size_t size)
 {
-	size_t i;
-	bool delta = false;
+	size_t i = 0;
+	flag_word delta = 0;
+
+	for (; i + FLAG_WORD_BYTES <= size; i += FLAG_WORD_BYTES) {
+		flag_word w1 = flag_load(flags1 + i), w2 = flag_load(flags2 + i);
 
-	for (i = 0; i < size; i++) {
 		/* !flag_is_subset() */
-		if (~flags1[i] & flags2[i]) delta = true;
+		delta |= ~w1 & w2;
 
+		flag_store(flags1 + i, w1 | w2);
+	}
+	for (; i < size; i++) {
+		delta |= (bitflag) (~flags1[i] & flags2[i]);
 		flags1[i] |= flags2[i];
 	}
 
-	return delta;
+	return delta != 0;
 }
 
 
@@ -331,18 +399,23 @@ bool flag_union(bitflag *flags1, const bitflag *flags2, const size_t size)
  */
 bool flag_inter(bitflag *flags1, const bitflag *flags2, const size_t size)
 {
-	size_t i;
-	bool delta = false;
+	size_t i = 0;
+	flag_word delta = 0;
+
+	for (; i + FLAG_WORD_BYTES <= size; i += FLAG_WORD_BYTES) {
+		flag_word w1 = flag_load(flags1 + i), w2 = flag_load(flags2 + i);
 
-	for (i = 0; i < size; i++) {
 		/* !flag_is_equal() */
-		if (!(flags1[i] == flags2[i])) delta = true;
+		delta |= w1 ^ w2;
 
+		flag_store(flags1 + i, w1 & w2);
+	}
+	for (; i < size; i++) {
+		delta |= flags1[i] ^ flags2[i];
 		flags1[i] &= flags2[i];
 	}
 
-	return delta;
-
+	return delta != 0;
 }
 
 
@@ -355,17 +428,23 @@ bool flag_inter(bitflag *flags1, const bitflag *flags2, const size_t size)
  */
 bool flag_diff(bitflag *flags1, const bitflag *flags2, const size_t size)
 {
-	size_t i;
-	bool delta = false;
+	size_t i = 0;
+	flag_word delta = 0;
+
+	for (; i + FLAG_WORD_BYTES <= size; i += FLAG_WORD_BYTES) {
+		flag_word w1 = flag_load(flags1 + i), w2 = flag_load(flags2 + i);
 
-	for (i = 0; i < size; i++) {
 		/* flag_is_inter() */
-		if (flags1[i] & flags2[i]) delta = true;
+		delta |= w1 & w2;
 
+		flag_store(flags1 + i, w1 & ~w2);
+	}
+	for (; i < size; i++) {
+		delta |= flags1[i] & flags2[i];
 		flags1[i] &= ~flags2[i];
 	}
 
-	return delta;
+	return delta != 0;
 }
 
 
@@ -566,10 +645,13 @@ bool flags_mask(bitflag *flags, const size_t size, ...)
 	va_list args;
 	bool delta = false;
 
-	bitflag *mask;
+	/* Flag sets are small; only very large ones need the heap */
+	bitflag local[64];
+	bitflag *mask = (size <= N_ELEMENTS(local)) ? local :
+		mem_alloc(size * sizeof(bitflag));
 
 	/* Build the mask */
-	mask = mem_zalloc(size * sizeof(bitflag));
+	flag_wipe(mask, size);
 
 	va_start(args, size);
 
@@ -582,8 +664,7 @@ bool flags_mask(bitflag *flags, const size_t size, ...)
 	delta = flag_inter(flags, mask, size);
 
 	/* Free the mask */
-
-	mem_free(mask);
+	if (mask != local) mem_free(mask);
 
 	return delta;
 }
@@ -88,7 +88,17 @@ void flags_init     (bitflag *flags, const size_t size, ...);
 bool flags_mask     (bitflag *flags, const size_t size, ...);
 
 #ifdef NDEBUG
-#define flag_has_dbg(flags, size, flag, fi, fl) flag_has(flags, size, flag)
+/**
+ * Without the debugging checks a single flag test is cheap enough that the
+ * call would cost more than the test, so do it in place.
+ */
+static inline bool flag_has_fast(const bitflag *flags, const int flag)
+{
+	return flag != FLAG_END
+		&& (flags[FLAG_OFFSET(flag)] & FLAG_BINARY(flag));
+}
+
+#define flag_has_dbg(flags, size, flag, fi, fl) flag_has_fast(flags, flag)
 #define flag_on_dbg(flags, size, flag, fi, fl) flag_on(flags, size, flag)
 #else
 bool flag_has_dbg   (const bitflag *flags, const size_t size, const int flag,